@@ -0,0 +1,153 @@
+#include "bitmatrix.h"
+#include <assert.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__)
+#define POPCOUNT64(x)	__builtin_popcountll(x)
+#define CTZ64(x)		__builtin_ctzll(x)
+#else
+static int popcount64(uint64_t x)
+{
+	int n = 0;
+
+	for (; x != 0; x &= x - 1)
+		n++;
+
+	return n;
+}
+
+static int ctz64(uint64_t x)
+{
+	int n = 0;
+
+	assert(x != 0);
+	for (; (x & 1u) == 0; x >>= 1)
+		n++;
+
+	return n;
+}
+#define POPCOUNT64(x)	popcount64(x)
+#define CTZ64(x)		ctz64(x)
+#endif
+
+BITMATRIX* bitmatrix_create(int nrows, int ncols)
+{
+	BITMATRIX *matrix;
+
+	assert(nrows >= 0);
+	assert(ncols >= 0);
+
+	matrix = (BITMATRIX*) malloc(sizeof(BITMATRIX));
+	if (matrix == NULL)
+		return NULL;
+
+	matrix->nrows = nrows;
+	matrix->ncols = ncols;
+	matrix->nwords = bitset_nwords(ncols);
+	matrix->nuses = 1;
+	matrix->ownswords = 1;
+	matrix->words = (uint64_t*) calloc((size_t) nrows * matrix->nwords + 1, sizeof(uint64_t));
+	if (matrix->words == NULL)
+	{
+		free(matrix);
+		return NULL;
+	}
+
+	return matrix;
+}
+
+BITMATRIX* bitmatrix_wrap(const uint64_t* words, int nrows, int ncols)
+{
+	BITMATRIX *matrix;
+
+	matrix = (BITMATRIX*) malloc(sizeof(BITMATRIX));
+	if (matrix == NULL)
+		return NULL;
+
+	matrix->nrows = nrows;
+	matrix->ncols = ncols;
+	matrix->nwords = bitset_nwords(ncols);
+	matrix->nuses = 1;
+	matrix->ownswords = 0;
+	matrix->words = (uint64_t*) words;
+
+	return matrix;
+}
+
+void bitmatrix_capture(BITMATRIX* matrix)
+{
+	assert(matrix != NULL);
+	assert(matrix->nuses >= 1);
+
+	matrix->nuses++;
+}
+
+void bitmatrix_release(BITMATRIX** matrix)
+{
+	assert(matrix != NULL);
+	assert(*matrix != NULL);
+	assert((*matrix)->nuses >= 1);
+
+	if (--(*matrix)->nuses == 0)
+	{
+		if ((*matrix)->ownswords)
+			free((*matrix)->words);
+		free(*matrix);
+	}
+
+	*matrix = NULL;
+}
+
+void bitset_and(uint64_t* dst, const uint64_t* a, const uint64_t* b, int nwords)
+{
+	int w;
+
+	for (w = 0; w < nwords; ++w)
+		dst[w] = a[w] & b[w];
+}
+
+int bitset_popcount(const uint64_t* a, int nwords)
+{
+	int n = 0;
+	int w;
+
+	for (w = 0; w < nwords; ++w)
+		n += POPCOUNT64(a[w]);
+
+	return n;
+}
+
+int bitset_and_popcount(const uint64_t* a, const uint64_t* b, int nwords)
+{
+	int n = 0;
+	int w;
+
+	for (w = 0; w < nwords; ++w)
+		n += POPCOUNT64(a[w] & b[w]);
+
+	return n;
+}
+
+int bitset_next(const uint64_t* a, int nwords, int from)
+{
+	uint64_t word;
+	int w;
+
+	if (from < 0)
+		from = 0;
+
+	w = from >> 6;
+	if (w >= nwords)
+		return -1;
+
+	// mask out the bits below from in the first word
+	word = a[w] & (~(uint64_t) 0 << (from & 63));
+	while (word == 0)
+	{
+		if (++w == nwords)
+			return -1;
+		word = a[w];
+	}
+
+	return (w << 6) + CTZ64(word);
+}
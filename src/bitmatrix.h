@@ -0,0 +1,105 @@
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* boolean matrix stored row by row in 64 bit words; the matrix is reference
+ * counted so that the original and the transformed problem share one copy */
+struct bit_matrix
+{
+	uint64_t*	words;
+	int			nrows;
+	int			ncols;
+	int			nwords;			/* words per row */
+	int			nuses;			/* number of references */
+	int			ownswords;		/* are the words freed with the matrix? */
+};
+
+typedef struct bit_matrix BITMATRIX;
+
+/* creates a matrix with all entries zero and one reference, NULL if out of
+ * memory */
+extern BITMATRIX*
+bitmatrix_create(int nrows, int ncols);
+
+/* creates a matrix with one reference on top of words that stay owned by
+ * the caller, e.g. a mapped file; the words are never written. Returns NULL
+ * if out of memory */
+extern BITMATRIX*
+bitmatrix_wrap(const uint64_t* words, int nrows, int ncols);
+
+/* adds a reference */
+extern void
+bitmatrix_capture(BITMATRIX* matrix);
+
+/* drops a reference, frees the matrix with the last one and sets *matrix to NULL */
+extern void
+bitmatrix_release(BITMATRIX** matrix);
+
+/* dst = a & b */
+extern void
+bitset_and(uint64_t* dst, const uint64_t* a, const uint64_t* b, int nwords);
+
+/* number of set bits */
+extern int
+bitset_popcount(const uint64_t* a, int nwords);
+
+/* number of set bits of a & b */
+extern int
+bitset_and_popcount(const uint64_t* a, const uint64_t* b, int nwords);
+
+/* index of the first set bit >= from, or -1 */
+extern int
+bitset_next(const uint64_t* a, int nwords, int from);
+
+/* number of words needed for n bits */
+static inline
+int bitset_nwords(int n)
+{
+	return (n + 63) >> 6;
+}
+
+static inline
+int bitset_get(const uint64_t* a, int i)
+{
+	return (int) ((a[i >> 6] >> (i & 63)) & 1u);
+}
+
+static inline
+void bitset_set(uint64_t* a, int i)
+{
+	a[i >> 6] |= (uint64_t) 1 << (i & 63);
+}
+
+static inline
+void bitset_clear(uint64_t* a, int i)
+{
+	a[i >> 6] &= ~((uint64_t) 1 << (i & 63));
+}
+
+/* row i as a bitset of nwords words */
+static inline
+const uint64_t* bitmatrix_row(const BITMATRIX* matrix, int i)
+{
+	return matrix->words + (size_t) i * matrix->nwords;
+}
+
+static inline
+int bitmatrix_get(const BITMATRIX* matrix, int i, int j)
+{
+	return bitset_get(bitmatrix_row(matrix, i), j);
+}
+
+static inline
+void bitmatrix_set(BITMATRIX* matrix, int i, int j, int val)
+{
+	uint64_t* row = matrix->words + (size_t) i * matrix->nwords;
+
+	if (val)
+		bitset_set(row, j);
+	else
+		bitset_clear(row, j);
+}
+
+#endif
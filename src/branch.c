@@ -0,0 +1,526 @@
+#include <assert.h>
+#include <string.h>
+
+#include "branch.h"
+#include "cons_samediff.h"
+#include "cons_testonvehicle.h"
+#include "cons_testorderonvehicle.h"
+#include "probdata_tp3s.h"
+#include "vardata_tp3s.h"
+
+#define BRANCHRULE_NAME            "ryanfoster"
+#define BRANCHRULE_DESC            "Ryan/Foster branching on test pairs, test on vehicle and test order on vehicle"
+#define BRANCHRULE_PRIORITY        50000
+#define BRANCHRULE_MAXDEPTH        -1
+#define BRANCHRULE_MAXBOUNDDIST    1.0
+
+/** returns how far a weight is from the nearest integer, 0 for integral weights */
+static
+SCIP_Real fractionality(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_Real             weight              /**< summed LP value of some columns */
+   )
+{
+   SCIP_Real frac;
+
+   if( SCIPisFeasIntegral(scip, weight) )
+      return 0.0;
+
+   frac = weight - SCIPfloor(scip, weight);
+
+   return MIN(frac, 1.0 - frac);
+}
+
+/** returns the hash map key of a pair, assignment or order index; shifted by one so that no key is NULL */
+static
+void* indexToKey(
+   size_t                index               /**< index of the pair, assignment or order */
+   )
+{
+   return (void*) (index + 1);
+}
+
+/** returns the pair, assignment or order index of a hash map key */
+static
+size_t keyToIndex(
+   void*                 key                 /**< hash map key */
+   )
+{
+   return (size_t) key - 1;
+}
+
+/** adds the LP value of a column to the weight of a pair, assignment or order */
+static
+SCIP_RETCODE addWeight(
+   SCIP_HASHMAP*         weights,            /**< weights of the pairs, assignments or orders seen so far */
+   size_t                index,              /**< index of the pair, assignment or order */
+   SCIP_Real             weight              /**< LP value of the column */
+   )
+{
+   SCIP_Real old = SCIPhashmapGetImageReal(weights, indexToKey(index));
+
+   if( old != SCIP_INVALID ) /*lint !e777*/
+      weight += old;
+
+   SCIP_CALL( SCIPhashmapSetImageReal(weights, indexToKey(index), weight) );
+
+   return SCIP_OKAY;
+}
+
+/** removes a pair, assignment or order that a decision on the path to the node already fixes; its weight can stay
+ *  fractional when the tests are covered more than once, and branching on it again would give a child equal to the
+ *  node */
+static
+SCIP_RETCODE dropDecided(
+   SCIP_HASHMAP*         weights,            /**< weights of the pairs, assignments or orders */
+   size_t                index               /**< index of the decided pair, assignment or order */
+   )
+{
+   if( SCIPhashmapExists(weights, indexToKey(index)) )
+   {
+      SCIP_CALL( SCIPhashmapRemove(weights, indexToKey(index)) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** finds the most fractional weight; returns FALSE if all weights are integral */
+static
+SCIP_Bool selectMostFractional(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_HASHMAP*         weights,            /**< weights of the pairs, assignments or orders */
+   size_t*               index               /**< pointer to store the index of the most fractional weight */
+   )
+{
+   SCIP_Real bestfrac = 0.0;
+   SCIP_Bool found = FALSE;
+   int nentries = SCIPhashmapGetNEntries(weights);
+
+   for( int e = 0; e < nentries; ++e )
+   {
+      SCIP_HASHMAPENTRY* entry = SCIPhashmapGetEntry(weights, e);
+      SCIP_Real frac;
+
+      if( entry == NULL )
+         continue;
+
+      frac = fractionality(scip, SCIPhashmapEntryGetImageReal(entry));
+
+      if( frac > bestfrac )
+      {
+         bestfrac = frac;
+         *index = keyToIndex(SCIPhashmapEntryGetOrigin(entry));
+         found = TRUE;
+      }
+   }
+
+   return found;
+}
+
+/** selects the pair of tests whose summed LP value over the columns serving both is most fractional */
+static
+SCIP_RETCODE selectTestPair(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR**            cols,               /**< columns with positive LP value */
+   SCIP_Real*            colssol,            /**< LP values of the columns */
+   int                   ncols,              /**< number of columns */
+   int                   numTests,           /**< number of tests */
+   int*                  tid1,               /**< pointer to store the first test, -1 if no pair is fractional */
+   int*                  tid2                /**< pointer to store the second test */
+   )
+{
+   SCIP_HASHMAP* weights;
+   SCIP_CONSHDLR* conshdlr;
+   size_t index;
+
+   SCIP_CALL( SCIPhashmapCreate(&weights, SCIPblkmem(scip), ncols) );
+
+   for( int c = 0; c < ncols; ++c )
+   {
+      SCIP_VARDATA* vardata = SCIPvarGetData(cols[c]);
+      int* consids = SCIPvardataGetConsids(vardata);
+      int nconsids = SCIPvardataGetNConsids(vardata);
+
+      /* consids are sorted, so the first test of a pair is the smaller one */
+      for( int i = 0; i < nconsids; ++i )
+         for( int j = i + 1; j < nconsids; ++j )
+         {
+            SCIP_CALL( addWeight(weights, (size_t) consids[i] * numTests + consids[j], colssol[c]) );
+         }
+   }
+
+   conshdlr = SCIPfindConshdlr(scip, "samediff");
+   if( conshdlr != NULL )
+   {
+      SCIP_CONS** conss = SCIPconshdlrGetConss(conshdlr);
+      int nconss = SCIPconshdlrGetNActiveConss(conshdlr);
+
+      for( int c = 0; c < nconss; ++c )
+      {
+         int t1 = SCIPgetTid1Samediff(scip, conss[c]);
+         int t2 = SCIPgetTid2Samediff(scip, conss[c]);
+
+         SCIP_CALL( dropDecided(weights, (size_t) MIN(t1, t2) * numTests + MAX(t1, t2)) );
+      }
+   }
+
+   *tid1 = -1;
+   *tid2 = -1;
+
+   if( selectMostFractional(scip, weights, &index) )
+   {
+      *tid1 = (int) (index / numTests);
+      *tid2 = (int) (index % numTests);
+   }
+
+   SCIPhashmapFree(&weights);
+
+   return SCIP_OKAY;
+}
+
+/** selects the test and vehicle whose summed LP value over the columns serving the test on the vehicle is most
+ *  fractional */
+static
+SCIP_RETCODE selectTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR**            cols,               /**< columns with positive LP value */
+   SCIP_Real*            colssol,            /**< LP values of the columns */
+   int                   ncols,              /**< number of columns */
+   int                   numVehicles,        /**< number of vehicle rows */
+   int*                  tid,                /**< pointer to store the test, -1 if no assignment is fractional */
+   int*                  vid                 /**< pointer to store the vehicle */
+   )
+{
+   SCIP_HASHMAP* weights;
+   SCIP_CONSHDLR* conshdlr;
+   size_t index;
+
+   SCIP_CALL( SCIPhashmapCreate(&weights, SCIPblkmem(scip), ncols) );
+
+   for( int c = 0; c < ncols; ++c )
+   {
+      SCIP_VARDATA* vardata = SCIPvarGetData(cols[c]);
+      int* consids = SCIPvardataGetConsids(vardata);
+      int nconsids = SCIPvardataGetNConsids(vardata);
+      int v = SCIPvardataGetVehicleConsids(vardata);
+
+      for( int i = 0; i < nconsids; ++i )
+      {
+         SCIP_CALL( addWeight(weights, (size_t) consids[i] * numVehicles + v, colssol[c]) );
+      }
+   }
+
+   conshdlr = SCIPfindConshdlr(scip, "testonvehicle");
+   if( conshdlr != NULL )
+   {
+      SCIP_CONS** conss = SCIPconshdlrGetConss(conshdlr);
+      int nconss = SCIPconshdlrGetNActiveConss(conshdlr);
+
+      for( int c = 0; c < nconss; ++c )
+      {
+         SCIP_CALL( dropDecided(weights, (size_t) SCIPgetTidTestOnVehicle(scip, conss[c]) * numVehicles
+               + SCIPgetVidTestOnVehicle(scip, conss[c])) );
+      }
+   }
+
+   *tid = -1;
+   *vid = -1;
+
+   if( selectMostFractional(scip, weights, &index) )
+   {
+      *tid = (int) (index / numVehicles);
+      *vid = (int) (index % numVehicles);
+   }
+
+   SCIPhashmapFree(&weights);
+
+   return SCIP_OKAY;
+}
+
+/** selects the ordered pair of tests and the vehicle whose summed LP value over the columns serving the first test
+ *  before the second on the vehicle is most fractional */
+static
+SCIP_RETCODE selectTestOrder(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR**            cols,               /**< columns with positive LP value */
+   SCIP_Real*            colssol,            /**< LP values of the columns */
+   int                   ncols,              /**< number of columns */
+   int                   numTests,           /**< number of tests */
+   int*                  tid1,               /**< pointer to store the test served first, -1 if no order is fractional */
+   int*                  tid2,               /**< pointer to store the test served second */
+   int*                  vid                 /**< pointer to store the vehicle */
+   )
+{
+   SCIP_HASHMAP* weights;
+   SCIP_CONSHDLR* conshdlr;
+   size_t index;
+
+   SCIP_CALL( SCIPhashmapCreate(&weights, SCIPblkmem(scip), ncols) );
+
+   for( int c = 0; c < ncols; ++c )
+   {
+      SCIP_VARDATA* vardata = SCIPvarGetData(cols[c]);
+      int* sequence = SCIPvardataGetSequence(vardata);
+      int nconsids = SCIPvardataGetNConsids(vardata);
+      size_t v = (size_t) SCIPvardataGetVehicleConsids(vardata);
+
+      for( int i = 0; i < nconsids; ++i )
+         for( int j = i + 1; j < nconsids; ++j )
+         {
+            SCIP_CALL( addWeight(weights, (v * numTests + sequence[i]) * numTests + sequence[j], colssol[c]) );
+         }
+   }
+
+   conshdlr = SCIPfindConshdlr(scip, "testorderonvehicle");
+   if( conshdlr != NULL )
+   {
+      SCIP_CONS** conss = SCIPconshdlrGetConss(conshdlr);
+      int nconss = SCIPconshdlrGetNActiveConss(conshdlr);
+
+      for( int c = 0; c < nconss; ++c )
+      {
+         size_t v = (size_t) SCIPgetVidTestOrderOnVehicle(scip, conss[c]);
+
+         SCIP_CALL( dropDecided(weights, (v * numTests + SCIPgetTid1TestOrderOnVehicle(scip, conss[c])) * numTests
+               + SCIPgetTid2TestOrderOnVehicle(scip, conss[c])) );
+      }
+   }
+
+   *tid1 = -1;
+   *tid2 = -1;
+   *vid = -1;
+
+   if( selectMostFractional(scip, weights, &index) )
+   {
+      *tid2 = (int) (index % numTests);
+      index /= numTests;
+      *tid1 = (int) (index % numTests);
+      *vid = (int) (index / numTests);
+   }
+
+   SCIPhashmapFree(&weights);
+
+   return SCIP_OKAY;
+}
+
+/** creates a child node with the given branching constraint */
+static
+SCIP_RETCODE addChild(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_NODE*            child,              /**< the child node */
+   SCIP_CONS*            cons                /**< branching constraint of the child */
+   )
+{
+   SCIP_CALL( SCIPaddConsNode(scip, child, cons, NULL) );
+   SCIP_CALL( SCIPreleaseCons(scip, &cons) );
+
+   return SCIP_OKAY;
+}
+
+/** branches on the first of the following that is fractional: a pair of tests served by the same column
+ *  (samediff), a test served on a vehicle (testonvehicle), and a test served before another on a vehicle
+ *  (testorderonvehicle)
+ */
+static
+SCIP_RETCODE branchOnColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR**            cols,               /**< columns with positive LP value */
+   SCIP_Real*            colssol,            /**< LP values of the columns */
+   int                   ncols,              /**< number of columns */
+   int                   numVehicles,        /**< number of vehicle rows */
+   int                   numTests,           /**< number of tests */
+   SCIP_RESULT*          result              /**< pointer to store the result of the branching call */
+   )
+{
+   SCIP_NODE* child1;
+   SCIP_NODE* child2;
+   SCIP_CONS* cons1;
+   SCIP_CONS* cons2;
+   char name[SCIP_MAXSTRLEN];
+   int tid1;
+   int tid2;
+   int vid;
+
+   SCIP_CALL( selectTestPair(scip, cols, colssol, ncols, numTests, &tid1, &tid2) );
+
+   if( tid1 >= 0 )
+   {
+      SCIPdebugMessage("branch on tests %d and %d\n", tid1, tid2);
+
+      SCIP_CALL( SCIPcreateChild(scip, &child1, 0.0, SCIPgetLocalTransEstimate(scip)) );
+      SCIP_CALL( SCIPcreateChild(scip, &child2, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "same_%d_%d", tid1, tid2);
+      SCIP_CALL( SCIPcreateConsSamediff(scip, &cons1, name, tid1, tid2, SAME, child1, TRUE) );
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "diff_%d_%d", tid1, tid2);
+      SCIP_CALL( SCIPcreateConsSamediff(scip, &cons2, name, tid1, tid2, DIFFER, child2, TRUE) );
+
+      SCIP_CALL( addChild(scip, child1, cons1) );
+      SCIP_CALL( addChild(scip, child2, cons2) );
+
+      *result = SCIP_BRANCHED;
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( selectTestOnVehicle(scip, cols, colssol, ncols, numVehicles, &tid1, &vid) );
+
+   if( tid1 >= 0 )
+   {
+      SCIPdebugMessage("branch on test %d on vehicle %d\n", tid1, vid);
+
+      SCIP_CALL( SCIPcreateChild(scip, &child1, 0.0, SCIPgetLocalTransEstimate(scip)) );
+      SCIP_CALL( SCIPcreateChild(scip, &child2, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "enforce_%d_on_%d", tid1, vid);
+      SCIP_CALL( SCIPcreateConsTestOnVehicle(scip, &cons1, name, tid1, vid, ENFORCE, child1, TRUE) );
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "forbid_%d_on_%d", tid1, vid);
+      SCIP_CALL( SCIPcreateConsTestOnVehicle(scip, &cons2, name, tid1, vid, FORBID, child2, TRUE) );
+
+      SCIP_CALL( addChild(scip, child1, cons1) );
+      SCIP_CALL( addChild(scip, child2, cons2) );
+
+      *result = SCIP_BRANCHED;
+      return SCIP_OKAY;
+   }
+
+   SCIP_CALL( selectTestOrder(scip, cols, colssol, ncols, numTests, &tid1, &tid2, &vid) );
+
+   if( tid1 >= 0 )
+   {
+      SCIPdebugMessage("branch on test %d before test %d on vehicle %d\n", tid1, tid2, vid);
+
+      SCIP_CALL( SCIPcreateChild(scip, &child1, 0.0, SCIPgetLocalTransEstimate(scip)) );
+      SCIP_CALL( SCIPcreateChild(scip, &child2, 0.0, SCIPgetLocalTransEstimate(scip)) );
+
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "enforce_%d_before_%d_on_%d", tid1, tid2, vid);
+      SCIP_CALL( SCIPcreateConsTestOrderOnVehicle(scip, &cons1, name, tid1, tid2, vid, ENFORCE, child1, TRUE) );
+      (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "forbid_%d_before_%d_on_%d", tid1, tid2, vid);
+      SCIP_CALL( SCIPcreateConsTestOrderOnVehicle(scip, &cons2, name, tid1, tid2, vid, FORBID, child2, TRUE) );
+
+      SCIP_CALL( addChild(scip, child1, cons1) );
+      SCIP_CALL( addChild(scip, child2, cons2) );
+
+      *result = SCIP_BRANCHED;
+      return SCIP_OKAY;
+   }
+
+   /* the columns cover some tests more than once; the caller falls back to the slack columns */
+   SCIPdebugMessage("no fractional test pair, assignment or order found\n");
+
+   return SCIP_OKAY;
+}
+
+/** branching execution method for fractional LP solutions; slack columns have no variable data and are only branched
+ *  on when the priced columns give no test pair, assignment or order to branch on. The slacks are never priced, so
+ *  fixing one does not hide a column from the pricer the way branching on a priced column would */
+static
+SCIP_DECL_BRANCHEXECLP(branchExeclpRyanFoster)
+{  /*lint --e{715}*/
+   SCIP_PROBDATA* probdata;
+   SCIP_VAR** lpcands;
+   SCIP_Real* lpcandssol;
+   SCIP_VAR** vars;
+   SCIP_VAR** cols;
+   SCIP_Real* colssol;
+   SCIP_VAR* slack;
+   SCIP_Real slackfrac;
+   int nlpcands;
+   int nvars;
+   int ncols;
+
+   assert(scip != NULL);
+   assert(branchrule != NULL);
+   assert(strcmp(SCIPbranchruleGetName(branchrule), BRANCHRULE_NAME) == 0);
+   assert(result != NULL);
+
+   SCIPdebugMessage("start branching at node %"SCIP_LONGINT_FORMAT", depth %d\n",
+      SCIPgetNNodes(scip), SCIPgetDepth(scip));
+
+   *result = SCIP_DIDNOTRUN;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   /* get fractional LP candidates */
+   SCIP_CALL( SCIPgetLPBranchCands(scip, &lpcands, &lpcandssol, NULL, &nlpcands, NULL, NULL) );
+   assert(nlpcands > 0);
+
+   /* the most fractional slack column is kept for the case that the priced columns give nothing to branch on */
+   slack = NULL;
+   slackfrac = 0.0;
+   for( int c = 0; c < nlpcands; ++c )
+   {
+      SCIP_Real frac;
+
+      if( SCIPvarGetData(lpcands[c]) != NULL )
+         continue;
+
+      frac = lpcandssol[c] - SCIPfloor(scip, lpcandssol[c]);
+      frac = MIN(frac, 1.0 - frac);
+
+      if( slack == NULL || frac > slackfrac )
+      {
+         slack = lpcands[c];
+         slackfrac = frac;
+      }
+   }
+
+   /* the weights are summed over all columns in the LP solution; integral columns serving a pair take part in its
+    * weight as much as fractional ones */
+   vars = SCIPprobdataGetVars(probdata);
+   nvars = SCIPprobdataGetNVars(probdata);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &cols, nvars) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colssol, nvars) );
+
+   ncols = 0;
+   for( int v = 0; v < nvars; ++v )
+   {
+      SCIP_Real sol = SCIPgetSolVal(scip, NULL, vars[v]);
+
+      if( !SCIPisFeasPositive(scip, sol) )
+         continue;
+
+      cols[ncols] = vars[v];
+      colssol[ncols] = sol;
+      ncols++;
+   }
+
+   SCIP_CALL( branchOnColumns(scip, cols, colssol, ncols, SCIPprobdataGetNumVehicleRows(probdata),
+         SCIPprobdataGetNumTests(probdata), result) );
+
+   if( *result == SCIP_DIDNOTRUN && slack != NULL )
+   {
+      SCIPdebugMessage("branch on slack column <%s>\n", SCIPvarGetName(slack));
+
+      SCIP_CALL( SCIPbranchVar(scip, slack, NULL, NULL, NULL) );
+      *result = SCIP_BRANCHED;
+   }
+
+   SCIPfreeBufferArray(scip, &colssol);
+   SCIPfreeBufferArray(scip, &cols);
+
+   return SCIP_OKAY;
+}
+
+/** creates the ryanfoster branching rule and includes it in SCIP */
+SCIP_RETCODE SCIPincludeBranchrule(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_BRANCHRULEDATA* branchruledata;
+   SCIP_BRANCHRULE* branchrule;
+
+   /* create ryanfoster branching rule data */
+   branchruledata = NULL;
+   branchrule = NULL;
+
+   /* include branching rule */
+   SCIP_CALL( SCIPincludeBranchruleBasic(scip, &branchrule, BRANCHRULE_NAME, BRANCHRULE_DESC, BRANCHRULE_PRIORITY,
+         BRANCHRULE_MAXDEPTH, BRANCHRULE_MAXBOUNDDIST, branchruledata) );
+   assert(branchrule != NULL);
+
+   SCIP_CALL( SCIPsetBranchruleExecLp(scip, branchrule, branchExeclpRyanFoster) );
+
+   return SCIP_OKAY;
+}
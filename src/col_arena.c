@@ -0,0 +1,96 @@
+#include "col_arena.h"
+#include "bitmatrix.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+COLARENA* colarena_create(int nbits, size_t chunkbytes)
+{
+	COLARENA* arena;
+
+	assert(nbits >= 0);
+	assert(chunkbytes > 0);
+
+	arena = (COLARENA*) malloc(sizeof(COLARENA));
+	if (arena == NULL)
+		return NULL;
+
+	arena->chunks = NULL;
+	arena->nchunks = 0;
+	arena->chunkssize = 0;
+	arena->chunkbytes = colarena_align(chunkbytes);
+	arena->lastbytes = 0;
+	arena->used = 0;
+	arena->nwords = bitset_nwords(nbits);
+	arena->nuses = 1;
+
+	return arena;
+}
+
+void colarena_capture(COLARENA* arena)
+{
+	assert(arena != NULL);
+	assert(arena->nuses >= 1);
+
+	arena->nuses++;
+}
+
+void colarena_release(COLARENA** arena)
+{
+	assert(arena != NULL);
+	assert(*arena != NULL);
+	assert((*arena)->nuses >= 1);
+
+	if (--(*arena)->nuses == 0)
+	{
+		for (int c = 0; c < (*arena)->nchunks; ++c)
+			free((*arena)->chunks[c]);
+		free((*arena)->chunks);
+		free(*arena);
+	}
+
+	*arena = NULL;
+}
+
+void* colarena_alloc(COLARENA* arena, size_t bytes)
+{
+	char* record;
+
+	assert(arena != NULL);
+
+	bytes = colarena_align(bytes);
+
+	/* a record that does not fit starts a new chunk, large records get a chunk of their own size */
+	if (arena->nchunks == 0 || arena->used + bytes > arena->lastbytes)
+	{
+		size_t size = bytes > arena->chunkbytes ? bytes : arena->chunkbytes;
+		char* chunk;
+
+		if (arena->nchunks == arena->chunkssize)
+		{
+			int nsize = arena->chunkssize > 0 ? 2 * arena->chunkssize : 8;
+			char** chunks = (char**) realloc(arena->chunks, nsize * sizeof(char*));
+
+			if (chunks == NULL)
+				return NULL;
+			arena->chunks = chunks;
+			arena->chunkssize = nsize;
+		}
+
+		// malloc aligns for every fundamental type, so records at multiples of 8 are aligned as well
+		chunk = (char*) malloc(size);
+		if (chunk == NULL)
+			return NULL;
+
+		arena->chunks[arena->nchunks++] = chunk;
+		arena->lastbytes = size;
+		arena->used = 0;
+	}
+
+	record = arena->chunks[arena->nchunks - 1] + arena->used;
+	arena->used += bytes;
+
+	memset(record, 0, bytes);
+
+	return record;
+}
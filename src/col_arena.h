@@ -0,0 +1,52 @@
+#ifndef COL_ARENA_H
+#define COL_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* append only storage for the data of the columns: records are handed out
+ * by bumping a pointer through chunks that never move, in the order the
+ * columns are created, and are only freed all at once with the arena. the
+ * arena is reference counted so that the original and the transformed
+ * problem can share it */
+struct col_arena
+{
+	char**		chunks;
+	int			nchunks;
+	int			chunkssize;
+	size_t		chunkbytes;		/* size of a regular chunk */
+	size_t		lastbytes;		/* size of the last chunk */
+	size_t		used;			/* bytes handed out of the last chunk */
+	int			nwords;			/* words of a test signature */
+	int			nuses;			/* number of references */
+};
+
+typedef struct col_arena COLARENA;
+
+/* creates an arena for columns over nbits tests with one reference;
+ * returns NULL on memory shortage */
+extern COLARENA*
+colarena_create(int nbits, size_t chunkbytes);
+
+/* adds a reference */
+extern void
+colarena_capture(COLARENA* arena);
+
+/* drops a reference, frees the arena and all its records with the last one
+ * and sets *arena to NULL */
+extern void
+colarena_release(COLARENA** arena);
+
+/* returns a cleared record of the given size, aligned for 64 bit words;
+ * returns NULL on memory shortage */
+extern void*
+colarena_alloc(COLARENA* arena, size_t bytes);
+
+/* number of bytes a record of size bytes takes, a multiple of 8 */
+static inline
+size_t colarena_align(size_t bytes)
+{
+	return (bytes + 7) & ~(size_t) 7;
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include "cons_samediff.h"
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "bitmatrix.h"
 
 #define CONSHDLR_NAME          "samediff"
 #define CONSHDLR_DESC          "stores the local branching decisions if two tests should come together"
@@ -22,7 +23,7 @@ struct SCIP_ConsData
 {
    int                   tid1;            /**< item id one */
    int                   tid2;            /**< item id two */
-   CONSTYPE              type;               /**< stores whether the items have to be in the SAME or DIFFER packing */
+   SAMEDIFFTYPE          type;               /**< stores whether the items have to be in the SAME or DIFFER packing */
    int                   npropagatedvars;    /**< number of variables that existed, the last time, the related node was
                                               *   propagated, used to determine whether the constraint should be
                                               *   repropagated*/
@@ -40,7 +41,7 @@ SCIP_RETCODE consdataCreate(
     SCIP_CONSDATA**    consdata,
     int               tid1,
     int               tid2,
-    CONSTYPE          type,
+    SAMEDIFFTYPE      type,
     SCIP_NODE*        node)
 {
     assert( scip != NULL);
@@ -87,17 +88,11 @@ SCIP_RETCODE checkVariable(
     SCIP_Bool*        cutoff)
 {
     SCIP_VARDATA* vardata;
-    int* testConsids;
-    int nconsids;
+    const uint64_t* signature;
 
     SCIP_Bool existid1;
     SCIP_Bool existid2;
-    CONSTYPE type;
-
-    SCIP_Bool fixed;
-    SCIP_Bool infeasible;
-
-    int pos;
+    SAMEDIFFTYPE type;
 
     assert(scip != NULL);
     assert(consdata != NULL);
@@ -112,44 +107,58 @@ SCIP_RETCODE checkVariable(
     /* check if the packing which corresponds to the variable feasible for this constraint */
     vardata = SCIPvarGetData(var);
 
-    nconsids = SCIPvardataGetNConsids(vardata);
-    testConsids = SCIPvardataGetConsids(vardata);
+    signature = SCIPvardataGetSignature(vardata);
 
-    existid1 = SCIPsortedvecFindInt(testConsids, consdata->tid1, nconsids, &pos);
-    existid2 = SCIPsortedvecFindInt(testConsids, consdata->tid2, nconsids, &pos);
+    existid1 = bitset_get(signature, consdata->tid1);
+    existid2 = bitset_get(signature, consdata->tid2);
     type = consdata->type;
 
     if ( (type == SAME && existid1 != existid2) ||  (type == DIFFER && existid1 && existid2))
     {
-        SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed));
-
-        if (infeasible)
-        {
-          assert( SCIPvarGetLbLocal(var) > 0.5);
-          SCIPdebugMessage("-> cutoff\n");
-          (*cutoff) = TRUE;
-        }
-        else
-        {
-          assert(fixed);
-          (*nfixedvars)++;
-        }
+        SCIP_CALL( SCIPfixVarTP3S(scip, var, cutoff, nfixedvars) );
     }
 
     return SCIP_OKAY;
 }
 
+/** checks the columns at the given positions of vars that were added since the last propagation */
+static
+SCIP_RETCODE checkColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONSDATA*        consdata,           /**< constraint data */
+   SCIP_VAR**            vars,               /**< generated variables */
+   int*                  cols,               /**< positions of the columns in vars, in increasing order */
+   int                   ncols,              /**< number of positions */
+   int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
+   SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
+   )
+{
+   int first;
+
+   /* the positions are increasing, so the unpropagated columns form a suffix */
+   (void) SCIPsortedvecFindInt(cols, consdata->npropagatedvars, ncols, &first);
+
+   for( int i = first; i < ncols && !(*cutoff); ++i )
+   {
+      SCIP_CALL( checkVariable(scip, consdata, vars[cols[i]], nfixedvars, cutoff) );
+   }
+
+   return SCIP_OKAY;
+}
+
 /** fixes variables to zero if the corresponding packings are not valid for this sonstraint/node (due to branching) */
 static 
 SCIP_RETCODE consdataFixVariables(
     SCIP*                   scip,
+    SCIP_PROBDATA*          probdata,
     SCIP_CONSDATA*          consdata,
     SCIP_VAR**              vars,
     int                     nvars,
     SCIP_RESULT*            result)
 {
     int nfixedvars;
-    int v;
+    int ntests1;
+    int ntests2;
     SCIP_Bool cutoff;
 
     nfixedvars = 0;
@@ -157,9 +166,19 @@ SCIP_RETCODE consdataFixVariables(
 
     SCIPdebugMessage("check variables %d to %d\n", consdata->npropagatedvars, nvars);
 
-    for (v=consdata->npropagatedvars; v < nvars && !cutoff; ++v)
+    ntests1 = SCIPprobdataGetNTestColumns(probdata, consdata->tid1);
+    ntests2 = SCIPprobdataGetNTestColumns(probdata, consdata->tid2);
+
+    /* only columns serving one of the tests can violate SAME, only those serving both can violate DIFFER */
+    if (consdata->type == SAME || ntests1 <= ntests2)
+    {
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, consdata->tid1), ntests1,
+            &nfixedvars, &cutoff) );
+    }
+    if (consdata->type == SAME || ntests1 > ntests2)
     {
-      SCIP_CALL(checkVariable(scip, consdata, vars[v], &nfixedvars, &cutoff));
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, consdata->tid2), ntests2,
+            &nfixedvars, &cutoff) );
     }
 
     SCIPdebugMessage("fixed %d variables locally\n", nfixedvars);
@@ -188,15 +207,13 @@ SCIP_Bool consdataCheck(
     SCIP_VARDATA* vardata;
     SCIP_VAR* var;
 
-    int* testConsids;
-    int nconsids;
+    const uint64_t* signature;
 
     SCIP_Bool existid1;
     SCIP_Bool existid2;
 
-    CONSTYPE type;
+    SAMEDIFFTYPE type;
 
-    int pos;
     int v;
 
     vars = SCIPprobdataGetVars(probdata);
@@ -212,11 +229,10 @@ SCIP_Bool consdataCheck(
 
       vardata = SCIPvarGetData(var);
 
-      testConsids = SCIPvardataGetConsids(vardata);
-      nconsids = SCIPvardataGetNConsids(vardata);
+      signature = SCIPvardataGetSignature(vardata);
 
-      existid1 = SCIPsortedvecFindInt(testConsids, consdata->tid1, nconsids, &pos);
-      existid2 = SCIPsortedvecFindInt(testConsids, consdata->tid2, nconsids, &pos);
+      existid1 = bitset_get(signature, consdata->tid1);
+      existid2 = bitset_get(signature, consdata->tid2);
       type = consdata->type;
 
       if( (type == SAME && existid1 != existid2) || (type == DIFFER && existid1 && existid2) )
@@ -337,7 +353,7 @@ SCIP_DECL_CONSPROP(consPropSamediff)
 
         for (i=c+1; i <nconss; i++)
         {
-          consdata2 = SCIPconsGetData(cons[i]);
+          consdata2 = SCIPconsGetData(conss[i]);
           assert(!(consdata->tid1 == consdata2->tid1 
               && consdata->tid2 == consdata2->tid2 
               && consdata->type == consdata2->type));
@@ -353,7 +369,7 @@ SCIP_DECL_CONSPROP(consPropSamediff)
       {
         SCIPdebugMessage("propagate constraint <%s> ", SCIPconsGetName(conss[c]));
 
-        SCIP_CALL( consdataFixVariables(scip, consdata, vars, nvars, result));
+        SCIP_CALL( consdataFixVariables(scip, probdata, consdata, vars, nvars, result));
         consdata->npropagations++;
 
         if (*result != SCIP_CUTOFF)
@@ -487,7 +503,7 @@ SCIP_RETCODE SCIPcreateConsSamediff(
    const char*           name,               /**< name of constraint */
    int                   tid1,            /**< item id one */
    int                   tid2,            /**< item id two */
-   CONSTYPE              type,               /**< stores whether the items have to be in the SAME or DIFFER packing */
+   SAMEDIFFTYPE          type,               /**< stores whether the items have to be in the SAME or DIFFER packing */
    SCIP_NODE*            node,               /**< the node in the B&B-tree at which the cons is sticking */
    SCIP_Bool             local               /**< is constraint only valid locally? */
    )
@@ -546,7 +562,7 @@ int SCIPgetTid2Samediff(
 }
 
 /** return constraint type SAME or DIFFER */
-CONSTYPE SCIPgetTypeSamediff(
+SAMEDIFFTYPE SCIPgetTypeSamediff(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONS*            cons                /**< samediff constraint */
    )
@@ -560,3 +576,73 @@ CONSTYPE SCIPgetTypeSamediff(
 
    return consdata->type;
 }
+
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+SCIP_Bool SCIPisPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->propagated;
+}
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+int SCIPgetNPropagatedVarsSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->npropagatedvars;
+}
+
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+void SCIPmarkPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< samediff constraint */
+   int                   nvars               /**< number of columns checked */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+   assert(nvars >= consdata->npropagatedvars);
+
+   consdata->propagated = TRUE;
+   consdata->npropagatedvars = nvars;
+   consdata->npropagations++;
+}
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+void SCIPresetPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   consdata->propagated = FALSE;
+   consdata->npropagatedvars = 0;
+}
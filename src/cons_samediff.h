@@ -3,12 +3,12 @@
 
 #include "scip/scip.h"
 
-enum ConsType
+enum SameDiffType
 {
 	SAME = 1,
 	DIFFER = 0
 };
-typedef enum ConsType CONSTYPE;
+typedef enum SameDiffType SAMEDIFFTYPE;
 
 /** creates the handler for element constraints and includes it in SCIP */
 extern
@@ -24,7 +24,7 @@ SCIP_RETCODE SCIPcreateConsSamediff(
    const char*           name,               /**< name of constraint */
    int                   tid1,            /**< item id one */
    int                   tid2,            /**< item id two */
-   CONSTYPE              type,               /**< stores whether the items have to be in the SAME or DIFFER packing */
+   SAMEDIFFTYPE          type,               /**< stores whether the items have to be in the SAME or DIFFER packing */
    SCIP_NODE*            node,               /**< the node in the B&B-tree at which the cons is sticking */
    SCIP_Bool             local               /**< is constraint only valid locally? */
    );
@@ -45,11 +45,39 @@ int SCIPgetTid2Samediff(
 
 /** return constraint type SAME or DIFFER */
 extern
-CONSTYPE SCIPgetTypeSamediff(
+SAMEDIFFTYPE SCIPgetTypeSamediff(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONS*            cons                /**< samediff constraint */
    );
 
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+extern
+SCIP_Bool SCIPisPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   );
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+extern
+int SCIPgetNPropagatedVarsSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   );
 
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+extern
+void SCIPmarkPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< samediff constraint */
+   int                   nvars               /**< number of columns checked */
+   );
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+extern
+void SCIPresetPropagatedSamediff(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< samediff constraint */
+   );
 
 #endif
\ No newline at end of file
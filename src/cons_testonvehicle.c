@@ -4,6 +4,7 @@
 #include "cons_testonvehicle.h"
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "bitmatrix.h"
 
 #define CONSHDLR_NAME          "testonvehicle"
 #define CONSHDLR_DESC          "stores the local branching decisions a test should be assigned to one vehicle"
@@ -83,18 +84,12 @@ SCIP_RETCODE checkVariable(
    )
 {
 	SCIP_VARDATA* vardata;
-	int* testConsids;
-	int nconsids;
+	const uint64_t* signature;
 	int vehicleIds;
 
 	SCIP_Bool existid;
 	CONSTYPE type;
 
-	SCIP_Bool fixed;
-	SCIP_Bool infeasible;
-
-	int pos;
-
 	assert(scip != NULL);
    	assert(consdata != NULL);
    	assert(var != NULL);
@@ -108,40 +103,54 @@ SCIP_RETCODE checkVariable(
     /* check if the packing which corresponds to the variable feasible for this constraint */
    	vardata = SCIPvarGetData(var);
 
-   	testConsids = SCIPvardataGetConsids(vardata);
-   	nconsids = SCIPvardataGetNConsids(vardata);
+   	signature = SCIPvardataGetSignature(vardata);
    	vehicleIds = SCIPvardataGetVehicleConsids(vardata);
 
-   	existid = SCIPsortedvecFindInt(testConsids, consdata->tid, nconsids, &pos);
+   	existid = bitset_get(signature, consdata->tid);
    	type = consdata->type;
 
    	/** situations the ub needs to be 0:
    		ENFORCE the test to be assigned to the test, but the column assigns the test to other vehicle
    		FORBID such assignment, but the column makes the assignment */
    	if ((type == ENFORCE && existid && (consdata->vid != vehicleIds))
-   			|| (type == FORBID && existid && (consdata->vid = vehicleIds)))
+   			|| (type == FORBID && existid && (consdata->vid == vehicleIds)))
    	{
-   		SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
-      	if( infeasible )
-      	{
-        	assert( SCIPvarGetLbLocal(var) > 0.5 );
-        	SCIPdebugMessage("-> cutoff\n");
-        	(*cutoff) = TRUE;
-      	}
-      	else
-      	{
-        	assert(fixed);
-       		(*nfixedvars)++;
-      	}
+   		SCIP_CALL( SCIPfixVarTP3S(scip, var, cutoff, nfixedvars) );
    	}
 
    	return SCIP_OKAY;
 }
 
+/** checks the columns at the given positions of vars that were added since the last propagation */
+static
+SCIP_RETCODE checkColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONSDATA*        consdata,           /**< constraint data */
+   SCIP_VAR**            vars,               /**< generated variables */
+   int*                  cols,               /**< positions of the columns in vars, in increasing order */
+   int                   ncols,              /**< number of positions */
+   int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
+   SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
+   )
+{
+   int first;
+
+   /* the positions are increasing, so the unpropagated columns form a suffix */
+   (void) SCIPsortedvecFindInt(cols, consdata->npropagatedvars, ncols, &first);
+
+   for( int i = first; i < ncols && !(*cutoff); ++i )
+   {
+      SCIP_CALL( checkVariable(scip, consdata, vars[cols[i]], nfixedvars, cutoff) );
+   }
+
+   return SCIP_OKAY;
+}
+
 /** fixes variables to zero if the corresponding packings are not valid for this sonstraint/node (due to branching) */
 static
 SCIP_RETCODE consdataFixVariables(
    SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
    SCIP_CONSDATA*        consdata,           /**< constraint data */
    SCIP_VAR**            vars,               /**< generated variables */
    int                   nvars,              /**< number of generated variables */
@@ -149,7 +158,6 @@ SCIP_RETCODE consdataFixVariables(
    )
 {
 	int nfixedvars;
-   	int v;
    	SCIP_Bool cutoff;
 
    	nfixedvars = 0;
@@ -157,10 +165,9 @@ SCIP_RETCODE consdataFixVariables(
 
    	SCIPdebugMessage("check variables %d to %d\n", consdata->npropagatedvars, nvars);
 
-   	for( v = consdata->npropagatedvars; v < nvars && !cutoff; ++v )
-   	{
-      	SCIP_CALL( checkVariable(scip, consdata, vars[v], &nfixedvars, &cutoff) );
-   	}
+   	/* only columns serving the test can violate the constraint */
+   	SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, consdata->tid),
+   		SCIPprobdataGetNTestColumns(probdata, consdata->tid), &nfixedvars, &cutoff) );
 
    	SCIPdebugMessage("fixed %d variables locally\n", nfixedvars);
 
@@ -187,13 +194,11 @@ SCIP_Bool consdataCheck(
 	SCIP_VARDATA* vardata;
 	SCIP_VAR* var;
 
-	int* testConsids;
-	int nconsids;
+	const uint64_t* signature;
 	int vehicleIds;
 	SCIP_Bool existid;
 	CONSTYPE type;
 
-	int pos;
 	int v;
 
    	vars = SCIPprobdataGetVars(probdata);
@@ -209,16 +214,16 @@ SCIP_Bool consdataCheck(
       	/* check if the packing which corresponds to the variable is feasible for this constraint */
       	vardata = SCIPvarGetData(var);
 
-      	testConsids = SCIPvardataGetConsids(vardata);
-      	nconsids = SCIPvardataGetNConsids(vardata);
-		existid = SCIPsortedvecFindInt(testConsids, consdata->tid, nconsids, &pos);
+      	signature = SCIPvardataGetSignature(vardata);
+      	vehicleIds = SCIPvardataGetVehicleConsids(vardata);
+		existid = bitset_get(signature, consdata->tid);
    		type = consdata->type;
 
    		/** situations the ub needs to be 0:
    			ENFORCE the test to be assigned to the test, but the column assigns the test to other vehicle
    			FORBID such assignment, but the column makes the assignment */
-   		if (type == ENFORCE && existid && (consdata->vid != vehicleIds)
-   			|| type == FORBID && existid && (consdata->vid = vehicleIds))
+   		if ((type == ENFORCE && existid && (consdata->vid != vehicleIds))
+   			|| (type == FORBID && existid && (consdata->vid == vehicleIds)))
    		{
    			SCIPdebug( SCIPvardataPrint(scip, vardata, NULL) );
          	SCIPdebug( consdataPrint(scip, consdata, NULL) );
@@ -349,7 +354,7 @@ SCIP_DECL_CONSPROP(consPropTestOnVehicle)
    			SCIPdebugMessage("propagate constraint <%s> ", SCIPconsGetName(conss[c]));
    			SCIPdebug( consdataPrint(scip, consdata, NULL) );
 
-         	SCIP_CALL( consdataFixVariables(scip, consdata, vars, nvars, result) );
+         	SCIP_CALL( consdataFixVariables(scip, probdata, consdata, vars, nvars, result) );
          	consdata->npropagations++;
 
          	if (*result != SCIP_CUTOFF)
@@ -557,3 +562,72 @@ CONSTYPE SCIPgetTypeTestOnVehicle(
 	return consdata->type;
 }
 
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+SCIP_Bool SCIPisPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->propagated;
+}
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+int SCIPgetNPropagatedVarsTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->npropagatedvars;
+}
+
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+void SCIPmarkPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< test on vehicle constraint */
+   int                   nvars               /**< number of columns checked */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+   assert(nvars >= consdata->npropagatedvars);
+
+   consdata->propagated = TRUE;
+   consdata->npropagatedvars = nvars;
+   consdata->npropagations++;
+}
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+void SCIPresetPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   consdata->propagated = FALSE;
+   consdata->npropagatedvars = 0;
+}
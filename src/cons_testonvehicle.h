@@ -50,4 +50,35 @@ CONSTYPE SCIPgetTypeTestOnVehicle(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONS*            cons                /**< samediff constraint */
    );
+
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+extern
+SCIP_Bool SCIPisPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   );
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+extern
+int SCIPgetNPropagatedVarsTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   );
+
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+extern
+void SCIPmarkPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< test on vehicle constraint */
+   int                   nvars               /**< number of columns checked */
+   );
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+extern
+void SCIPresetPropagatedTestOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test on vehicle constraint */
+   );
+
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "cons_testorderonvehicle.h"
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "bitmatrix.h"
 
 #define CONSHDLR_NAME          "testorderonvehicle"
 #define CONSHDLR_DESC          "stores the local branching decisions two tests should be assigned in order to a vehicle "
@@ -20,10 +21,10 @@
 
 struct SCIP_ConsData
 {
-   int                   tid1;            /**< item id one */
-   int 					         tid2	
-   int                   vid;            /**< item id two */
-   CONSTYPE              type;               /**< stores whether the items have to be in the SAME or DIFFER packing */
+   int                   tid1;            /**< test served first */
+   int                   tid2;            /**< test served second */
+   int                   vid;             /**< vehicle id */
+   CONSTYPE              type;               /**< stores whether the order on the vehicle is ENFORCEd or FORBIDden */
    int                   npropagatedvars;    /**< number of variables that existed, the last time, the related node was
                                               *   propagated, used to determine whether the constraint should be
                                               *   repropagated*/
@@ -36,10 +37,10 @@ static
 SCIP_RETCODE consdataCreate(
   SCIP*                   scip,               /**< SCIP data structure */
     SCIP_CONSDATA**       consdata,               /**< pointer to hold the created constraint */
-    int                   tid1,
-    int                   tid2,               /**< item id one */
+    int                   tid1,               /**< test served first */
+    int                   tid2,               /**< test served second */
     int                   vid,         /**< vehicle id */
-    CONSTYPE              type,               /**< stores whether the items have to be in the SAME or DIFFER packing */
+    CONSTYPE              type,               /**< stores whether the order on the vehicle is ENFORCEd or FORBIDden */
     SCIP_NODE*            node              /**< the node in the B&B-tree at which the cons is sticking */
   )
 {
@@ -47,6 +48,7 @@ SCIP_RETCODE consdataCreate(
   assert( consdata != NULL);
   assert( tid1 >= 0);
   assert( tid2 >= 0);
+  assert( tid1 != tid2);
   assert( vid >= 0);
   assert( type == ENFORCE || type == FORBID);
     
@@ -77,6 +79,44 @@ void consdataPrint(
     consdata->tid1, consdata->tid2, consdata->vid, SCIPnodeGetNumber(consdata->node) );
 }
 
+/** returns whether the column of the variable data is not valid for this constraint */
+static
+SCIP_Bool columnViolates(
+  SCIP_CONSDATA*        consdata,           /**< constraint data */
+  SCIP_VARDATA*         vardata             /**< variable data of the column */
+  )
+{
+    const uint64_t* signature;
+    int* sequence;
+    int existid1;
+    int existid2;
+    int i;
+
+    signature = SCIPvardataGetSignature(vardata);
+    existid1 = bitset_get(signature, consdata->tid1);
+    existid2 = bitset_get(signature, consdata->tid2);
+
+    /** situations the ub needs to be 0:
+    ENFORCE the constraint, col contains only one of the tests
+    ENFORCE the constraint, col contains both tests but on a different vehicle or in the other order
+    FORBID the constraint, col serves both tests on the vehicle in this order */
+    if (existid1 != existid2)
+      return consdata->type == ENFORCE;
+
+    if (!existid1)
+      return FALSE;
+
+    if (SCIPvardataGetVehicleConsids(vardata) != consdata->vid)
+      return consdata->type == ENFORCE;
+
+    /* both tests on the vehicle, only the order decides */
+    sequence = SCIPvardataGetSequence(vardata);
+    for (i = 0; sequence[i] != consdata->tid1 && sequence[i] != consdata->tid2; ++i)
+      ;
+
+    return (sequence[i] == consdata->tid1) == (consdata->type == FORBID);
+}
+
 /** fixes a variable to zero if the corresponding packings are not valid for this constraint/node (due to branching) */
 static
 SCIP_RETCODE checkVariable(
@@ -86,24 +126,7 @@ SCIP_RETCODE checkVariable(
    int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
    SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
    )
-
 {
-
-    /** need to consider the different column cost thing */
-    SCIP_VARDATA* vardata;
-    int* testConsids;
-    int nconsids;
-    int vehicleIds;  
-
-    SCIP_Bool existid1;
-    SCIP_Bool existid2;
-    CONSTYPE type;
-
-    SCIP_Bool fixed;
-    SCIP_Bool infeasible;
-
-    int pos;
-
     assert(scip != NULL);
     assert(consdata != NULL);
     assert(var != NULL);
@@ -114,45 +137,412 @@ SCIP_RETCODE checkVariable(
     if( SCIPvarGetUbLocal(var) < 0.5 )
       return SCIP_OKAY;
 
-
     /* check if the packing which corresponds to the variable feasible for this constraint */
-    vardata = SCIPvarGetData(var);
+    if (columnViolates(consdata, SCIPvarGetData(var)))
+    {       
+        SCIP_CALL( SCIPfixVarTP3S(scip, var, cutoff, nfixedvars) );
+    }
+
+    return SCIP_OKAY;
+}
+
+/** checks the columns at the given positions of vars that were added since the last propagation */
+static
+SCIP_RETCODE checkColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONSDATA*        consdata,           /**< constraint data */
+   SCIP_VAR**            vars,               /**< generated variables */
+   int*                  cols,               /**< positions of the columns in vars, in increasing order */
+   int                   ncols,              /**< number of positions */
+   int*                  nfixedvars,         /**< pointer to store the number of fixed variables */
+   SCIP_Bool*            cutoff              /**< pointer to store if a cutoff was detected */
+   )
+{
+   int first;
 
-    testConsids = SCIPvardataGetConsids(vardata);
-    nconsids = SCIPvardataGetNConsids(vardata);
-    vehicleIds = SCIPvardataGetVehicleConsids(vardata);
+   /* the positions are increasing, so the unpropagated columns form a suffix */
+   (void) SCIPsortedvecFindInt(cols, consdata->npropagatedvars, ncols, &first);
 
-    existid1 = SCIPsortedvecFindInt(testConsids, consdata->tid1, nconsids, &pos);
-    existid2 = SCIPsortedvecFindInt(testConsids, consdata->tid2, nconsids, &pos);
-    type = consdata->type;
+   for( int i = first; i < ncols && !(*cutoff); ++i )
+   {
+      SCIP_CALL( checkVariable(scip, consdata, vars[cols[i]], nfixedvars, cutoff) );
+   }
 
-    /** situations the ub needs to be 0:
-    ENFORCE the constraint, col contains either tests but assign to different vehicle
-    ENFORCE the constraint, col contains single test 
-    FORBID the constraint, col contains both tests and assign to the vehicle */
-    if ((type==ENFORCE && existid1 && existid2 && vehicleIds!=consdata->vid)
-        || (type==ENFORCE && existid1 && !existid2)
-        || (type==ENFORCE && existid2 && !existid1)
-        || (type==FORBID && existid1 && existid2 && vehicleIds==consdata->vid))
-    {       
-        SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
-        if( infeasible )
+   return SCIP_OKAY;
+}
+
+/** fixes variables to zero if the corresponding packings are not valid for this constraint/node (due to branching) */
+static
+SCIP_RETCODE consdataFixVariables(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   SCIP_CONSDATA*        consdata,           /**< constraint data */
+   SCIP_VAR**            vars,               /**< generated variables */
+   int                   nvars,              /**< number of generated variables */
+   SCIP_RESULT*          result              /**< pointer to store the result of the fixing */
+   )
+{
+    int nfixedvars;
+    int ntests1;
+    int ntests2;
+    int nvehicle;
+    SCIP_Bool cutoff;
+
+    nfixedvars = 0;
+    cutoff = FALSE;
+
+    SCIPdebugMessage("check variables %d to %d\n", consdata->npropagatedvars, nvars);
+
+    ntests1 = SCIPprobdataGetNTestColumns(probdata, consdata->tid1);
+    ntests2 = SCIPprobdataGetNTestColumns(probdata, consdata->tid2);
+    nvehicle = SCIPprobdataGetNVehicleColumns(probdata, consdata->vid);
+
+    if (consdata->type == ENFORCE)
+    {
+      /* only columns serving one of the tests can violate ENFORCE */
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, consdata->tid1), ntests1,
+            &nfixedvars, &cutoff) );
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, consdata->tid2), ntests2,
+            &nfixedvars, &cutoff) );
+    }
+    else if (nvehicle < MIN(ntests1, ntests2))
+    {
+      /* only columns of the vehicle serving both tests can violate FORBID, take the shortest list */
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetVehicleColumns(probdata, consdata->vid), nvehicle,
+            &nfixedvars, &cutoff) );
+    }
+    else
+    {
+      int tid = ntests1 <= ntests2 ? consdata->tid1 : consdata->tid2;
+
+      SCIP_CALL( checkColumns(scip, consdata, vars, SCIPprobdataGetTestColumns(probdata, tid),
+            SCIPprobdataGetNTestColumns(probdata, tid), &nfixedvars, &cutoff) );
+    }
+
+    SCIPdebugMessage("fixed %d variables locally\n", nfixedvars);
+
+    if( cutoff )
+      *result = SCIP_CUTOFF;
+    else if( nfixedvars > 0 )
+      *result = SCIP_REDUCEDDOM;
+
+    return SCIP_OKAY;
+}
+
+#ifndef NDEBUG
+/** check if all variables are valid for the given consdata */
+static 
+SCIP_Bool consdataCheck(
+  SCIP*         scip, 
+  SCIP_PROBDATA*      probdata,
+  SCIP_CONSDATA*      consdata,
+  SCIP_Bool       beforeprop
+  )
+{
+    SCIP_VAR** vars;
+    int nvars;
+    int v;
+
+    vars = SCIPprobdataGetVars(probdata);
+    nvars = (beforeprop ? consdata->npropagatedvars : SCIPprobdataGetNVars(probdata));
+    assert(nvars <= SCIPprobdataGetNVars(probdata));
+
+    for (v = 0; v < nvars; v++)
+    {
+      /* if variables is locally fixed to zero continue */
+      if( SCIPvarGetLbLocal(vars[v]) < 0.5 )
+        continue;
+
+      if (columnViolates(consdata, SCIPvarGetData(vars[v])))
+      {
+        SCIPdebug( SCIPvardataPrint(scip, SCIPvarGetData(vars[v]), NULL) );
+        SCIPdebug( consdataPrint(scip, consdata, NULL) );
+        SCIPdebug( SCIPprintVar(scip, vars[v], NULL) );
+        return FALSE;
+      }
+    }
+    return TRUE;
+}
+#endif
+
+/** frees test order on vehicle constraint data */
+static
+SCIP_RETCODE consdataFree(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONSDATA**       consdata            /**< pointer to the constraint data */
+   )
+{
+    assert(consdata != NULL);
+    assert(*consdata != NULL);
+
+    SCIPfreeBlockMemory(scip, consdata);
+
+    return SCIP_OKAY;
+}
+
+/** frees specific constraint data */
+static
+SCIP_DECL_CONSDELETE(consDeleteTestOrderOnVehicle)
+{  /*lint --e{715}*/
+   assert(conshdlr != NULL);
+   assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+   assert(consdata != NULL);
+   assert(*consdata != NULL);
+
+   SCIP_CALL( consdataFree(scip, consdata) );
+
+   return SCIP_OKAY;
+}
+
+/** transforms constraint data into data belonging to the transformed problem */
+static
+SCIP_DECL_CONSTRANS(consTransTestOrderOnVehicle)
+{
+    SCIP_CONSDATA* sourcedata;
+    SCIP_CONSDATA* targetdata;
+
+    assert(conshdlr != NULL);
+    assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+    assert(SCIPgetStage(scip) == SCIP_STAGE_TRANSFORMING);
+    assert(sourcecons != NULL);
+    assert(targetcons != NULL);
+
+    sourcedata = SCIPconsGetData(sourcecons);
+    assert(sourcedata != NULL);
+
+    /* create constraint data for target constraint */
+    SCIP_CALL( consdataCreate(scip, &targetdata,
+      sourcedata->tid1, sourcedata->tid2, sourcedata->vid, sourcedata->type, sourcedata->node));
+
+    /* create target constraint */
+    SCIP_CALL( SCIPcreateCons(scip, targetcons, SCIPconsGetName(sourcecons), conshdlr, targetdata,
+         SCIPconsIsInitial(sourcecons), SCIPconsIsSeparated(sourcecons), SCIPconsIsEnforced(sourcecons),
+         SCIPconsIsChecked(sourcecons), SCIPconsIsPropagated(sourcecons),
+         SCIPconsIsLocal(sourcecons), SCIPconsIsModifiable(sourcecons),
+         SCIPconsIsDynamic(sourcecons), SCIPconsIsRemovable(sourcecons), SCIPconsIsStickingAtNode(sourcecons)) );
+
+    return SCIP_OKAY;
+}
+
+/** constraint enforcing method of constraint handler for LP solutions */
+#define consEnfolpTestOrderOnVehicle NULL
+
+/** constraint enforcing method of constraint handler for pseudo solutions */
+#define consEnfopsTestOrderOnVehicle NULL
+
+/** feasibility check method of constraint handler for integral solutions */
+#define consCheckTestOrderOnVehicle NULL
+
+/** domain propagation method of constraint handler */
+static
+SCIP_DECL_CONSPROP(consPropTestOrderOnVehicle)
+{
+    SCIP_PROBDATA* probdata;
+    SCIP_CONSDATA* consdata;
+
+    SCIP_VAR** vars;
+    int nvars;
+    int c;
+
+    assert(scip != NULL);
+    assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+    assert(result != NULL);
+
+    SCIPdebugMessage("propagation constraints of constraint handler <"CONSHDLR_NAME">\n");
+
+    probdata = SCIPgetProbData(scip);
+    assert( probdata != NULL);
+
+    vars = SCIPprobdataGetVars(probdata);
+    nvars = SCIPprobdataGetNVars(probdata);
+
+    *result = SCIP_DIDNOTFIND;
+
+    for (c=0; c<nconss; ++c)
+    {
+      consdata = SCIPconsGetData(conss[c]);
+#ifndef NDEBUG
+      {
+          /* check if there are no equal consdatas */
+          SCIP_CONSDATA* consdata2;
+          int i;
+
+          for (i=c+1; i<nconss; ++i)
+          {
+            consdata2 = SCIPconsGetData(conss[i]);
+            assert( !(consdata->tid1 == consdata2->tid1
+              && consdata->tid2 == consdata2->tid2
+              && consdata->vid == consdata2->vid
+              && consdata->type == consdata2->type));
+          }
+      }
+#endif
+      if (!consdata->propagated)
+      {
+        SCIPdebugMessage("propagate constraint <%s> ", SCIPconsGetName(conss[c]));
+        SCIPdebug( consdataPrint(scip, consdata, NULL) );
+
+        SCIP_CALL( consdataFixVariables(scip, probdata, consdata, vars, nvars, result) );
+        consdata->npropagations++;
+
+        if (*result != SCIP_CUTOFF)
         {
-          assert( SCIPvarGetLbLocal(var) > 0.5 );
-          SCIPdebugMessage("-> cutoff\n");
-          (*cutoff) = TRUE;
+          consdata->propagated = TRUE;
+          consdata->npropagatedvars = nvars;
         }
         else
-        {
-          assert(fixed);
-          (*nfixedvars)++;
-        }
+          break;
+      }
+
+      assert( consdataCheck(scip, probdata, consdata, FALSE));
     }
 
     return SCIP_OKAY;
+}
+
+/** variable rounding lock method of constraint handler */
+#define consLockTestOrderOnVehicle NULL
+
+/** constraint activation notification method of constraint handler */
+static 
+SCIP_DECL_CONSACTIVE(consActiveTestOrderOnVehicle)
+{
+    SCIP_CONSDATA* consdata;
+    SCIP_PROBDATA* probdata;
+
+    assert(scip != NULL);
+    assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+    assert(cons != NULL);
+
+    probdata = SCIPgetProbData(scip);
+    assert(probdata != NULL);
+
+    consdata = SCIPconsGetData(cons);
+    assert(consdata != NULL);
+    assert(consdata->npropagatedvars <= SCIPprobdataGetNVars(probdata));
+
+    SCIPdebugMessage("activate constraint <%s> at node <%"SCIP_LONGINT_FORMAT"> in depth <%d>: ",
+      SCIPconsGetName(cons), SCIPnodeGetNumber(consdata->node), SCIPnodeGetDepth(consdata->node));
+    SCIPdebug( consdataPrint(scip, consdata, NULL) );
+
+    if( consdata->npropagatedvars != SCIPprobdataGetNVars(probdata) )
+    {
+      SCIPdebugMessage("-> mark constraint to be repropagated\n");
+      consdata->propagated = FALSE;
+      SCIP_CALL( SCIPrepropagateNode(scip, consdata->node) );
+    }
+
+    /* check if all previously generated variables are valid for this constraint */
+    assert( consdataCheck(scip, probdata, consdata, TRUE) );
+
+    return SCIP_OKAY;
+}
+
+/** constraint deactivation notification method of constraint handler */
+static 
+SCIP_DECL_CONSDEACTIVE(consDeactiveTestOrderOnVehicle)
+{
+    SCIP_CONSDATA* consdata;
+    SCIP_PROBDATA* probdata;
+
+    assert(scip != NULL);
+    assert(strcmp(SCIPconshdlrGetName(conshdlr), CONSHDLR_NAME) == 0);
+    assert(cons != NULL);
+
+    consdata = SCIPconsGetData(cons);
+    assert(consdata != NULL);
+    assert(consdata->propagated || SCIPgetNChildren(scip) == 0);
+
+    probdata = SCIPgetProbData(scip);
+    assert(probdata != NULL);
+
+    SCIPdebugMessage("deactivate constraint <%s> at node <%"SCIP_LONGINT_FORMAT"> in depth <%d>: ",
+      SCIPconsGetName(cons), SCIPnodeGetNumber(consdata->node), SCIPnodeGetDepth(consdata->node));
+    SCIPdebug( consdataPrint(scip, consdata, NULL) );
+
+    /* set the number of propagated variables to current number of variables is SCIP */
+    consdata->npropagatedvars = SCIPprobdataGetNVars(probdata);
+
+    return SCIP_OKAY;
+}
+
+/** constraint display method of constraint handler */
+static
+SCIP_DECL_CONSPRINT(consPrintTestOrderOnVehicle)
+{  /*lint --e{715}*/
+    SCIP_CONSDATA*  consdata;
+
+    consdata = SCIPconsGetData(cons);
+    assert(consdata != NULL);
+
+    consdataPrint(scip, consdata, file);
+
+    return SCIP_OKAY;
+}
+
+/** creates the handler for test order on vehicle constraints and includes it in SCIP */
+SCIP_RETCODE SCIPincludeConshdlrTestOrderOnVehicle(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+    SCIP_CONSHDLRDATA* conshdlrdata = NULL;
+    SCIP_CONSHDLR* conshdlr = NULL;
+
+    /* include constraint handler */
+    SCIP_CALL( SCIPincludeConshdlrBasic(scip, &conshdlr, CONSHDLR_NAME, CONSHDLR_DESC,
+         CONSHDLR_ENFOPRIORITY, CONSHDLR_CHECKPRIORITY, CONSHDLR_EAGERFREQ, CONSHDLR_NEEDSCONS,
+         consEnfolpTestOrderOnVehicle, consEnfopsTestOrderOnVehicle, consCheckTestOrderOnVehicle,
+         consLockTestOrderOnVehicle, conshdlrdata) );
+
+    assert(conshdlr != NULL);
 
+    SCIP_CALL( SCIPsetConshdlrDelete(scip, conshdlr, consDeleteTestOrderOnVehicle) );
+    SCIP_CALL( SCIPsetConshdlrTrans(scip, conshdlr, consTransTestOrderOnVehicle) );
+    SCIP_CALL( SCIPsetConshdlrProp(scip, conshdlr, consPropTestOrderOnVehicle, CONSHDLR_PROPFREQ, CONSHDLR_DELAYPROP,
+         CONSHDLR_PROP_TIMING) );
+    SCIP_CALL( SCIPsetConshdlrActive(scip, conshdlr, consActiveTestOrderOnVehicle) );
+    SCIP_CALL( SCIPsetConshdlrDeactive(scip, conshdlr, consDeactiveTestOrderOnVehicle) );
+    SCIP_CALL( SCIPsetConshdlrPrint(scip, conshdlr, consPrintTestOrderOnVehicle) );
+
+    return SCIP_OKAY;
 }
 
+/** creates and captures a test order on vehicle constraint */
+SCIP_RETCODE SCIPcreateConsTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS**           cons,               /**< pointer to hold the created constraint */
+   const char*           name,               /**< name of constraint */
+   int                   tid1,               /**< test served first */
+   int                   tid2,               /**< test served second */
+   int                   vid,                /**< vehicle id */
+   CONSTYPE              type,               /**< stores whether the order on the vehicle is ENFORCEd or FORBIDden */
+   SCIP_NODE*            node,               /**< the node in the B&B-tree at which the cons is sticking */
+   SCIP_Bool             local               /**< is constraint only valid locally? */
+   )
+{
+    SCIP_CONSHDLR* conshdlr;
+    SCIP_CONSDATA* consdata;
+
+    /* find the test order on vehicle constraint handler */
+    conshdlr = SCIPfindConshdlr(scip, CONSHDLR_NAME);
+    if( conshdlr == NULL )
+    {
+      SCIPerrorMessage("test order on vehicle constraint handler not found\n");
+      return SCIP_PLUGINNOTFOUND;
+    }
+
+    /* create the constraint specific data */
+    SCIP_CALL( consdataCreate(scip, &consdata, tid1, tid2, vid, type, node) );
+
+    /* create constraint */
+    SCIP_CALL( SCIPcreateCons(scip, cons, name, conshdlr, consdata, FALSE, FALSE, FALSE, FALSE, TRUE,
+         local, FALSE, FALSE, FALSE, TRUE) );
+
+    SCIPdebugMessage("created constraint: ");
+    SCIPdebug( consdataPrint(scip, consdata, NULL) );
+
+    return SCIP_OKAY;
+}
 
 int SCIPgetTid1TestOrderOnVehicle(
    SCIP*                 scip,               /**< SCIP data structure */
@@ -199,7 +589,7 @@ int SCIPgetVidTestOrderOnVehicle(
 	return consdata->vid;
 }
 
-int SCIPgetTypeTestOrderOnVehicle(
+CONSTYPE SCIPgetTypeTestOrderOnVehicle(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONS*            cons                /**< samediff constraint */
    )
@@ -212,4 +602,74 @@ int SCIPgetTypeTestOrderOnVehicle(
 	assert(consdata != NULL);
 
 	return consdata->type;
-}
\ No newline at end of file
+}
+
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+SCIP_Bool SCIPisPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->propagated;
+}
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+int SCIPgetNPropagatedVarsTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   return consdata->npropagatedvars;
+}
+
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+void SCIPmarkPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< test order on vehicle constraint */
+   int                   nvars               /**< number of columns checked */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+   assert(nvars >= consdata->npropagatedvars);
+
+   consdata->propagated = TRUE;
+   consdata->npropagatedvars = nvars;
+   consdata->npropagations++;
+}
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+void SCIPresetPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   )
+{
+   SCIP_CONSDATA* consdata;
+
+   assert(cons != NULL);
+
+   consdata = SCIPconsGetData(cons);
+   assert(consdata != NULL);
+
+   consdata->propagated = FALSE;
+   consdata->npropagatedvars = 0;
+}
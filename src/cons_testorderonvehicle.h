@@ -2,13 +2,7 @@
 #define _SCIP_CONS_TESTORDERONVEHICLE_H_ 
 
 #include "scip/scip.h"
-
-enum ConsType 
-{
-	ENFORCE = 1,
-	FORBID = 0
-}
-typedef enum ConsType CONSTYPE;
+#include "cons_testonvehicle.h"
 
 /** creates the handler for element constraints and includes it in SCIP */
 extern
@@ -16,7 +10,8 @@ SCIP_RETCODE SCIPincludeConshdlrTestOrderOnVehicle(
    SCIP*                 scip                /**< SCIP data structure */
    );
 
-/** creates and captures a testOnVehicle constraint */
+/** creates and captures a testOrderOnVehicle constraint; ENFORCE serves tid1 before tid2 on the vehicle, FORBID
+ *  forbids that order on the vehicle */
 extern
 SCIP_RETCODE SCIPcreateConsTestOrderOnVehicle(
    SCIP*                 scip,               /**< SCIP data structure */
@@ -52,10 +47,41 @@ int SCIPgetVidTestOrderOnVehicle(
    );
 
 
-/** return constraint type ALLOW or FORBID */
+/** return constraint type ENFORCE or FORBID */
 extern
 CONSTYPE SCIPgetTypeTestOrderOnVehicle(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_CONS*            cons                /**< samediff constraint */
    );
+
+/** returns whether the constraint is propagated for all columns that existed when it was last propagated */
+extern
+SCIP_Bool SCIPisPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   );
+
+/** returns the number of columns the constraint was propagated for, the later ones still have to be checked */
+extern
+int SCIPgetNPropagatedVarsTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   );
+
+/** marks the constraint as propagated for the first nvars columns, used when another plugin did the fixings */
+extern
+void SCIPmarkPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< test order on vehicle constraint */
+   int                   nvars               /**< number of columns checked */
+   );
+
+/** marks the constraint as propagated for no column, used when the columns moved to other positions of the
+ *  variable array */
+extern
+void SCIPresetPropagatedTestOrderOnVehicle(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< test order on vehicle constraint */
+   );
+
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef DATA_STRUCTURE_H
 #define DATA_STRUCTURE_H
 
+#include "bitmatrix.h"
+
 struct test_request
 {
 	unsigned int dur;
@@ -19,6 +21,20 @@ struct vehicle
 typedef struct test_request TEST;
 typedef struct vehicle VEHICLE;
 
+/* a complete problem instance, tests are indexed by their dense id */
+struct instance
+{
+	TEST*		tests;
+	VEHICLE*	vehicles;
+	BITMATRIX*	rehits;			/* rehits[i][j]: may test j follow test i */
+	int*		idRemap;		/* test id of the file -> dense id, -1 if unused */
+	int			numTests;
+	int			numVehicles;
+	int			maxTestId;
+};
+
+typedef struct instance INSTANCE;
+
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include <assert.h>
+#include <string.h>
+
+#include "heur_listschedule.h"
+#include "list_schedule.h"
+#include "probdata_tp3s.h"
+#include "schedule.h"
+
+#define HEUR_NAME              "listschedule"
+#define HEUR_DESC              "assigns the tests by deadline or release greedily to the vehicles"
+#define HEUR_DISPCHAR          'L'
+#define HEUR_PRIORITY          10000
+#define HEUR_FREQ              10
+#define HEUR_FREQOFS           0
+#define HEUR_MAXDEPTH          -1
+#define HEUR_TIMING            SCIP_HEURTIMING_BEFORENODE
+#define HEUR_USESSUBSCIP       FALSE
+
+#define DEFAULT_NOISE          1.0           /**< largest shift of a deadline in perturbed runs, relative to the test duration */
+#define DEFAULT_RANDSEED       71            /**< initial random seed */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   SCIP_RANDNUMGEN*      randnumgen;         /**< random number generator for the perturbed orders */
+   SCIP_Real             noise;              /**< largest shift of a deadline, relative to the test duration */
+   int                   nruns;              /**< number of calls so far */
+};
+
+/** destructor of the heuristic, frees the heuristic data */
+static
+SCIP_DECL_HEURFREE(heurFreeListSchedule)
+{
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeBlockMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** initialization of the heuristic, creates the random number generator */
+static
+SCIP_DECL_HEURINIT(heurInitListSchedule)
+{
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIP_CALL( SCIPcreateRandom(scip, &heurdata->randnumgen, DEFAULT_RANDSEED, TRUE) );
+   heurdata->nruns = 0;
+
+   return SCIP_OKAY;
+}
+
+/** deinitialization of the heuristic, frees the random number generator */
+static
+SCIP_DECL_HEUREXIT(heurExitListSchedule)
+{
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeRandom(scip, &heurdata->randnumgen);
+
+   return SCIP_OKAY;
+}
+
+/** execution method of the heuristic: the first run orders the tests by deadline, the second by release and every
+ *  later one by deadlines shifted at random; a schedule serving all tests that beats the incumbent becomes a
+ *  solution of master columns */
+static
+SCIP_DECL_HEUREXEC(heurExecListSchedule)
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_PROBDATA* probdata;
+   SCIP_SOL* sol;
+   const TEST* tests;
+   const VEHICLE* vehicles;
+   int* vehicleClass;
+   int* keys;
+   int* order;
+   int* seqs;
+   int* lens;
+   SCIP_Real cost;
+   SCIP_Bool stored;
+   int numTests;
+   int numVehicles;
+   int nleft;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   probdata = SCIPgetProbData(scip);
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   tests = SCIPprobdataGetTests(probdata);
+   vehicles = SCIPprobdataGetVehicles(probdata);
+   vehicleClass = SCIPprobdataIsAggregated(probdata) ? SCIPprobdataGetVehicleClass(probdata) : NULL;
+   numTests = SCIPprobdataGetNumTests(probdata);
+   numVehicles = SCIPprobdataGetNumVehicles(probdata);
+
+   if( numTests == 0 || numVehicles == 0 )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &keys, numTests) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &order, numTests) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &seqs, numVehicles * numTests) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &lens, numVehicles) );
+
+   for( int i = 0; i < numTests; ++i )
+   {
+      if( heurdata->nruns == 1 )
+         keys[i] = (int) tests[i].release;
+      else
+      {
+         keys[i] = (int) tests[i].deadline;
+
+         if( heurdata->nruns >= 2 && heurdata->noise > 0.0 )
+            keys[i] += SCIPrandomGetInt(heurdata->randnumgen, 0, (int) (heurdata->noise * tests[i].dur));
+      }
+      order[i] = i;
+   }
+   SCIPsortIntInt(keys, order, numTests);
+
+   heurdata->nruns++;
+
+   nleft = list_schedule(tests, vehicles, numTests, numVehicles, SCIPprobdataGetRehitRules(probdata), order, seqs,
+      lens);
+   if( nleft < 0 )
+   {
+      SCIPfreeBufferArray(scip, &lens);
+      SCIPfreeBufferArray(scip, &seqs);
+      SCIPfreeBufferArray(scip, &order);
+      SCIPfreeBufferArray(scip, &keys);
+      return SCIP_NOMEMORY;
+   }
+
+   /* a schedule leaving tests out is no solution, one not beating the incumbent is not worth its columns */
+   cost = 0.0;
+   for( int v = 0; v < numVehicles && nleft == 0; ++v )
+   {
+      if( lens[v] > 0 )
+         cost += sequence_cost(tests, seqs + v * numTests, lens[v], (int) vehicles[v].release);
+   }
+
+   if( nleft == 0 && SCIPisLT(scip, cost, SCIPgetUpperbound(scip)) )
+   {
+      SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+
+      for( int v = 0; v < numVehicles; ++v )
+      {
+         const int* seq = seqs + v * numTests;
+         SCIP_VAR* var;
+
+         if( lens[v] == 0 )
+            continue;
+
+         SCIP_CALL( SCIPprobdataGetSolColumn(scip, probdata, seq, lens[v], vehicleClass != NULL ? vehicleClass[v] : v,
+               sequence_cost(tests, seq, lens[v], (int) vehicles[v].release), &var) );
+         SCIP_CALL( SCIPsetSolVal(scip, sol, var, 1.0) );
+         SCIP_CALL( SCIPreleaseVar(scip, &var) );
+      }
+
+      SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+
+      SCIPdebugMessage("list schedule of cost %g %s\n", cost, stored ? "stored" : "rejected");
+
+      if( stored )
+         *result = SCIP_FOUNDSOL;
+   }
+
+   SCIPfreeBufferArray(scip, &lens);
+   SCIPfreeBufferArray(scip, &seqs);
+   SCIPfreeBufferArray(scip, &order);
+   SCIPfreeBufferArray(scip, &keys);
+
+   return SCIP_OKAY;
+}
+
+/** creates the list scheduling primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurListSchedule(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, &heurdata) );
+   heurdata->randnumgen = NULL;
+   heurdata->nruns = 0;
+
+   heur = NULL;
+
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecListSchedule, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreeListSchedule) );
+   SCIP_CALL( SCIPsetHeurInit(scip, heur, heurInitListSchedule) );
+   SCIP_CALL( SCIPsetHeurExit(scip, heur, heurExitListSchedule) );
+
+   SCIP_CALL( SCIPaddRealParam(scip, "heuristics/" HEUR_NAME "/noise",
+         "largest shift of a deadline in the perturbed runs, relative to the duration of the test (0: no perturbation)",
+         &heurdata->noise, FALSE, DEFAULT_NOISE, 0.0, SCIP_REAL_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,12 @@
+#ifndef _SCIP_HEUR_LISTSCHEDULE_H_
+#define _SCIP_HEUR_LISTSCHEDULE_H_
+
+#include "scip/scip.h"
+
+/** creates the list scheduling primal heuristic and includes it in SCIP */
+extern
+SCIP_RETCODE SCIPincludeHeurListSchedule(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
@@ -0,0 +1,203 @@
+#include <assert.h>
+#include <limits.h>
+
+#include "heur_pricedive.h"
+#include "probdata_tp3s.h"
+
+#define HEUR_NAME              "pricedive"
+#define HEUR_DESC              "fixes the master column with the largest LP value to one and prices, until the LP is integral"
+#define HEUR_DISPCHAR          'P'
+#define HEUR_PRIORITY          -1000
+#define HEUR_FREQ              10
+#define HEUR_FREQOFS           0
+#define HEUR_MAXDEPTH          -1
+#define HEUR_TIMING            SCIP_HEURTIMING_AFTERLPNODE
+#define HEUR_USESSUBSCIP       FALSE
+
+#define DEFAULT_MAXPRICEROUNDS -1            /**< maximal number of pricing rounds per LP of the dive (-1: no limit) */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+   int                   maxpricerounds;     /**< maximal number of pricing rounds per LP of the dive */
+   int                   nfixings;           /**< number of columns fixed in all dives */
+};
+
+/** returns the unfixed master column with the largest fractional LP value, ties going to the cheaper column, or NULL
+ *  if the LP value of every master column is integral; slack columns are not dived on */
+static
+SCIP_VAR* selectColumn(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   SCIP_VAR** vars;
+   SCIP_VAR* best;
+   SCIP_Real bestval;
+   int nvars;
+
+   vars = SCIPprobdataGetVars(probdata);
+   nvars = SCIPprobdataGetNVars(probdata);
+
+   best = NULL;
+   bestval = 0.0;
+   for( int i = 0; i < nvars; ++i )
+   {
+      SCIP_Real val;
+
+      if( SCIPvarGetUbLocal(vars[i]) < 0.5 || SCIPvarGetLbLocal(vars[i]) > 0.5 )
+         continue;
+
+      val = SCIPgetSolVal(scip, NULL, vars[i]);
+      if( SCIPisFeasIntegral(scip, val) )
+         continue;
+
+      if( best == NULL || val > bestval
+         || (val == bestval && SCIPvarGetObj(vars[i]) < SCIPvarGetObj(best)) )
+      {
+         best = vars[i];
+         bestval = val;
+      }
+   }
+
+   return best;
+}
+
+/** execution method of the heuristic: dives in probing mode by fixing one column per probing node to one, pricing
+ *  new columns into the LP after every fixing, and tries the LP solution once it is integral */
+static
+SCIP_DECL_HEUREXEC(heurExecPriceDive)
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_PROBDATA* probdata;
+   SCIP_Bool cutoff;
+   SCIP_Bool lperror;
+   int nfixings;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   probdata = SCIPgetProbData(scip);
+   if( probdata == NULL || nodeinfeasible )
+      return SCIP_OKAY;
+
+   if( !SCIPhasCurrentNodeLP(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL )
+      return SCIP_OKAY;
+
+   /* a dive from an LP no better than the incumbent finds nothing */
+   if( SCIPisGE(scip, SCIPgetLPObjval(scip), SCIPgetUpperbound(scip)) )
+      return SCIP_OKAY;
+
+   *result = SCIP_DIDNOTFIND;
+
+   SCIP_CALL( SCIPstartProbing(scip) );
+
+   nfixings = 0;
+   cutoff = FALSE;
+   lperror = FALSE;
+   while( !cutoff && !lperror && !SCIPisStopped(scip) )
+   {
+      SCIP_VAR* var;
+
+      /* pricing during the dive adds columns, so the column array is looked up afresh */
+      var = selectColumn(scip, probdata);
+
+      if( var == NULL )
+      {
+         SCIP_SOL* sol;
+         SCIP_Bool stored;
+
+         SCIP_CALL( SCIPcreateSol(scip, &sol, heur) );
+         SCIP_CALL( SCIPlinkLPSol(scip, sol) );
+         SCIP_CALL( SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored) );
+
+         SCIPdebugMessage("price and dive with %d fixings: solution %s\n", nfixings, stored ? "stored" : "rejected");
+
+         if( stored )
+            *result = SCIP_FOUNDSOL;
+         break;
+      }
+
+      SCIP_CALL( SCIPnewProbingNode(scip) );
+      SCIP_CALL( SCIPfixVarProbing(scip, var, 1.0) );
+      nfixings++;
+
+      /* only the packing row of the vehicle, or the capacity row of a full class, excludes other columns now; the
+       * test rows are covering rows, so columns serving the same tests stay free and merely become useless */
+      SCIP_CALL( SCIPpropagateProbing(scip, -1, &cutoff, NULL) );
+      if( cutoff )
+         break;
+
+      SCIP_CALL( SCIPsolveProbingLPWithPricing(scip, FALSE, FALSE, heurdata->maxpricerounds, &lperror, &cutoff) );
+      if( lperror || cutoff || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL )
+         break;
+
+      if( SCIPisGE(scip, SCIPgetLPObjval(scip), SCIPgetUpperbound(scip)) )
+         break;
+   }
+
+   heurdata->nfixings += nfixings;
+
+   SCIP_CALL( SCIPendProbing(scip) );
+
+   return SCIP_OKAY;
+}
+
+/** destructor of the heuristic, frees the heuristic data */
+static
+SCIP_DECL_HEURFREE(heurFreePriceDive)
+{
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPfreeBlockMemory(scip, &heurdata);
+   SCIPheurSetData(heur, NULL);
+
+   return SCIP_OKAY;
+}
+
+/** solving process deinitialization of the heuristic, reports the fixings of the dives */
+static
+SCIP_DECL_HEUREXITSOL(heurExitsolPriceDive)
+{
+   SCIP_HEURDATA* heurdata;
+
+   heurdata = SCIPheurGetData(heur);
+   assert(heurdata != NULL);
+
+   SCIPdebugMessage("price and dive: %d calls, %d fixings\n", (int) SCIPheurGetNCalls(heur), heurdata->nfixings);
+   heurdata->nfixings = 0;
+
+   return SCIP_OKAY;
+}
+
+/** creates the price and dive primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurPriceDive(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_HEURDATA* heurdata;
+   SCIP_HEUR* heur;
+
+   SCIP_CALL( SCIPallocBlockMemory(scip, &heurdata) );
+   heurdata->nfixings = 0;
+
+   heur = NULL;
+
+   SCIP_CALL( SCIPincludeHeurBasic(scip, &heur, HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ,
+         HEUR_FREQOFS, HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecPriceDive, heurdata) );
+   assert(heur != NULL);
+
+   SCIP_CALL( SCIPsetHeurFree(scip, heur, heurFreePriceDive) );
+   SCIP_CALL( SCIPsetHeurExitsol(scip, heur, heurExitsolPriceDive) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "heuristics/" HEUR_NAME "/maxpricerounds",
+         "maximal number of pricing rounds for the LP after each fixing of the dive (-1: no limit)",
+         &heurdata->maxpricerounds, FALSE, DEFAULT_MAXPRICEROUNDS, -1, INT_MAX, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,12 @@
+#ifndef _SCIP_HEUR_PRICEDIVE_H_
+#define _SCIP_HEUR_PRICEDIVE_H_
+
+#include "scip/scip.h"
+
+/** creates the price and dive primal heuristic and includes it in SCIP */
+extern
+SCIP_RETCODE SCIPincludeHeurPriceDive(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
@@ -1,66 +1,124 @@
 #include <jansson.h>
 #include "json_read.h"
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 
 // function prototypes
-static int get_max_test_id(const char* path);
-static void test_id_remap(const char* path, int *id_remap);
+static double seconds_since(clock_t start);
+static void read_in_tests(json_t *tests_json, TEST *testArr);
+static void read_in_vehicles(json_t *vehicles_json, VEHICLE *vehicleArr);
+static int* test_id_remap(json_t *tests_json, int *max_test_id);
+static void read_in_rehit_rules(json_t *rules, const int *id_remap, int max_test_id, int num_test, BITMATRIX *rule);
 
-int get_tests_size(const char* path)
+int read_in_instance(const char* path, INSTANCE* inst, LOADTIMES* times)
 {
-	json_t *root, *tests_json;
+	json_t *root, *tests_json, *vehicles_json, *rules;
 	json_error_t err;
-	size_t result;
+	clock_t start;
 
-	root = json_load_file(path,0, &err);
+	assert(inst != NULL);
+	assert(times != NULL);
 
+	inst->tests = NULL;
+	inst->vehicles = NULL;
+	inst->rehits = NULL;
+	inst->idRemap = NULL;
+	inst->numTests = 0;
+	inst->numVehicles = 0;
+	inst->maxTestId = -1;
+
+	// the only parse of the file, all phases below walk the same tree
+	start = clock();
+	root = json_load_file(path, 0, &err);
+	times->parse = seconds_since(start);
+
+	if (root == NULL)
+	{
+		fprintf(stderr, "%s:%d: %s\n", path, err.line, err.text);
+		return -1;
+	}
+
+	// json_object_get returns borrowed references, only root is released
 	tests_json = json_object_get(root, "tests");
+	vehicles_json = json_object_get(root, "vehicles");
+	rules = json_object_get(root, "rehit");
 
-	result = json_array_size(tests_json);
+	inst->numTests = json_array_size(tests_json);
+	inst->numVehicles = json_array_size(vehicles_json);
+
+	start = clock();
+	inst->tests = (TEST*) malloc(inst->numTests * sizeof(TEST));
+	if (inst->tests == NULL && inst->numTests > 0)
+		goto NOMEMORY;
+	read_in_tests(tests_json, inst->tests);
+	times->tests = seconds_since(start);
+
+	start = clock();
+	inst->vehicles = (VEHICLE*) malloc(inst->numVehicles * sizeof(VEHICLE));
+	if (inst->vehicles == NULL && inst->numVehicles > 0)
+		goto NOMEMORY;
+	read_in_vehicles(vehicles_json, inst->vehicles);
+	times->vehicles = seconds_since(start);
+
+	start = clock();
+	// pairs not listed in the file are not allowed
+	inst->rehits = bitmatrix_create(inst->numTests, inst->numTests);
+	if (inst->rehits == NULL)
+		goto NOMEMORY;
+	inst->idRemap = test_id_remap(tests_json, &inst->maxTestId);
+	if (inst->idRemap == NULL && inst->maxTestId >= 0)
+		goto NOMEMORY;
+	read_in_rehit_rules(rules, inst->idRemap, inst->maxTestId, inst->numTests, inst->rehits);
+	times->rehits = seconds_since(start);
 
 	json_decref(root);
-	json_decref(tests_json);
 
-	return result;
+	return 0;
 
+NOMEMORY:
+	fprintf(stderr, "%s: out of memory\n", path);
+	json_decref(root);
+	free_instance(inst);
+	return -1;
 }
 
-int get_vehicle_size(const char* path)
+void free_instance(INSTANCE* inst)
 {
-	json_t *root, *vehicles_json;
-	json_error_t err;
-	size_t result;
+	assert(inst != NULL);
 
-	root = json_load_file(path,0, &err);
-
-	vehicles_json = json_object_get(root, "vehicles");
-
-	result = json_array_size(vehicles_json);
+	if (inst->rehits != NULL)
+	{
+		bitmatrix_release(&inst->rehits);
+	}
+	free(inst->idRemap);
+	free(inst->vehicles);
+	free(inst->tests);
 
-	json_decref(root);
-	json_decref(vehicles_json);
+	inst->tests = NULL;
+	inst->vehicles = NULL;
+	inst->idRemap = NULL;
+}
 
-	return result;
+static
+double seconds_since(clock_t start)
+{
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
 }
 
-void read_in_tests(const char* path, TEST *testArr)
+static
+void read_in_tests(json_t *tests_json, TEST *testArr)
 {
-	json_t *root, *tests_json;
-	json_error_t err;
 	int i;
 
-	root = json_load_file(path, 0, &err);
-	tests_json = json_object_get(root, "tests");
-
 	for (i=0; i < json_array_size(tests_json); ++i)
 	{
-		int tid, dur, release, deadline;
+		int dur, release, deadline;
 		json_t *test;
 
 		test = json_array_get(tests_json, i);
-		tid = json_integer_value(json_object_get(test, "test_id"));
 		dur = json_integer_value(json_object_get(test, "dur"));
 		release = json_integer_value(json_object_get(test, "release"));
 		deadline = json_integer_value(json_object_get(test, "deadline"));
@@ -70,25 +128,14 @@ void read_in_tests(const char* path, TEST *testArr)
 		testArr[i].dur = dur;
 		testArr[i].release = release;
 		testArr[i].deadline = deadline;
-
-		json_decref(test);
-
 	}
-
-	json_decref(tests_json);
-	json_decref(root);
 }
 
-void read_in_vehicles(const char* path, VEHICLE *vehicleArr)
+static
+void read_in_vehicles(json_t *vehicle_json, VEHICLE *vehicleArr)
 {
-	json_t *root, *vehicle_json;
-	json_error_t err;
-
 	int i;
 
-	root = json_load_file(path, 0, &err);
-	vehicle_json = json_object_get(root, "vehicles");
-
 	for (i=0; i<json_array_size(vehicle_json); ++i)
 	{
 		int vid, release;
@@ -101,167 +148,95 @@ void read_in_vehicles(const char* path, VEHICLE *vehicleArr)
 
 		vehicleArr[i].vid = vid;
 		vehicleArr[i].release = release;
-
-		json_decref(vehicle);
 	}
-
-	json_decref(vehicle_json);
-	json_decref(root);
-
 }
 
-
-void read_in_rehit_rules(const char* path, int **rule)
+/* maps the test ids of the file to their position in the tests array,
+ * ids that do not belong to a test are mapped to -1; returns NULL on memory
+ * shortage */
+static
+int* test_id_remap(json_t *tests_json, int *max_test_id)
 {
-	// create the remap of tid to fake id used in this program
-	json_t *root, *rules;
-	json_error_t err;
 	int *id_remap;
+	int num_test;
+	int i;
 
-	void *iter, *inner_iter;
-	int max_test_id = get_max_test_id(path);
-	int num_test = get_tests_size(path);
+	num_test = json_array_size(tests_json);
 
-	// create a very large array
-	id_remap = (int*) malloc(max_test_id * sizeof(int));
-	// initialize all value to -1
-	for (int i=0; i < max_test_id; ++i)
+	// find the max test id
+	*max_test_id = -1;
+	for (i=0; i<num_test; ++i)
+	{
+		int tid;
+
+		tid = json_integer_value(json_object_get(json_array_get(tests_json, i), "test_id"));
+		if (tid > *max_test_id)
+		{
+			*max_test_id = tid;
+		}
+	}
+
+	id_remap = (int*) malloc((*max_test_id + 1) * sizeof(int));
+	if (id_remap == NULL)
+		return NULL;
+
+	for (i=0; i <= *max_test_id; ++i)
 	{
 		id_remap[i] = -1;
 	}
 
-	// fill in the remap
-	test_id_remap(path, id_remap);
+	for (i=0; i<num_test; ++i)
+	{
+		int tid;
 
-	// read the rules
-	root = json_load_file(path, 0, &err);
-	rules = json_object_get(root, "rehit");
+		tid = json_integer_value(json_object_get(json_array_get(tests_json, i), "test_id"));
+		if (tid >= 0)
+		{
+			id_remap[tid] = i;
+		}
+	}
 
-	iter = json_object_iter(rules);
+	return id_remap;
+}
 
+static
+void read_in_rehit_rules(json_t *rules, const int *id_remap, int max_test_id, int num_test, BITMATRIX *rule)
+{
+	void *iter, *inner_iter;
 
+	iter = json_object_iter(rules);
 
 	while (iter)
 	{
-		const char* key;
 		json_t *val;
-		int id1, id2, real_id1, real_id2;
-		int ok;
+		int id1, real_id1;
 
-		key = json_object_iter_key(iter);
+		id1 = atoi(json_object_iter_key(iter));
 		val = json_object_iter_value(iter);
 
-		id1 = atoi(key);
+		real_id1 = (id1 >= 0 && id1 <= max_test_id) ? id_remap[id1] : -1;
 
 		inner_iter = json_object_iter(val);
 
-		while (inner_iter)
+		while (real_id1 >= 0 && inner_iter)
 		{
-			const char* id2_str; 
-			json_t *allowable;
+			int id2, real_id2;
 
-			id2_str = json_object_iter_key(inner_iter);
-			id2 = atoi(id2_str);
-			allowable = json_object_iter_value(inner_iter);
+			id2 = atoi(json_object_iter_key(inner_iter));
+			real_id2 = (id2 >= 0 && id2 <= max_test_id) ? id_remap[id2] : -1;
 
-			if (json_is_true(allowable))
+			if (real_id2 >= 0)
 			{
-				ok = 1;
-			} 
-			else 
-			{
-				ok = 0;
-			}
+				assert(real_id1 < num_test);
+				assert(real_id2 < num_test);
 
-			// write the rule
-			real_id1 = id_remap[id1];
-			real_id2 = id_remap[id2];
-
-			assert(real_id1 >= 0 && real_id1 < num_test);
-			assert(real_id2 >= 0 && real_id2 < num_test);
-
-
-			rule[real_id1][real_id2] = ok;
+				// write the rule
+				bitmatrix_set(rule, real_id1, real_id2, json_is_true(json_object_iter_value(inner_iter)));
+			}
 
-			json_decref(allowable);
 			inner_iter = json_object_iter_next(val, inner_iter);
 		}
 
-		json_decref(val);
 		iter = json_object_iter_next(rules, iter);
 	}
-
-
-	json_decref(rules);
-	json_decref(root);
-
-	free(id_remap);
-
-
 }
-
-static 
-int get_max_test_id(const char* path)
-{
-	json_t *root, *tests_json;
-	json_error_t err;
-
-	int max_test_id = -1;
-	int num_test;
-
-	root = json_load_file(path, 0, &err);
-	tests_json = json_object_get(root, "tests");
-
-	// find the max test id
-	num_test = json_array_size(tests_json);
-	for (int i=0; i<num_test; ++i)
-	{
-		json_t *test;
-		int tid;
-		test = json_array_get(tests_json, i);
-
-		tid = json_integer_value(json_object_get(test, "test_id"));
-
-		if (tid > max_test_id)
-		{
-			max_test_id = tid;
-		}
-
-		json_decref(test);
-	}
-
-	json_decref(tests_json);
-	json_decref(root);
-
-	return max_test_id;
-}
-
-
-static 
-void test_id_remap(const char* path, int *id_remap)
-{
-	// read in test id
-	json_t *root, *tests_json;
-	json_error_t err;
-
-	int i;
-
-	root = json_load_file(path, 0, &err);
-	tests_json = json_object_get(root, "tests");
-
-	for (i=0; i<json_array_size(tests_json); ++i)
-	{
-		json_t *test;
-		int tid;
-		test = json_array_get(tests_json, i);
-		tid = json_integer_value(json_object_get(test, "test_id"));
-
-		id_remap[tid] = i;
-
-		json_decref(test);
-	}
-
-	json_decref(tests_json);
-	json_decref(root);
-
-}
\ No newline at end of file
@@ -3,21 +3,27 @@
 
 #include "data_structure.h"
 
-
-extern int 
-get_tests_size(const char* path);
-
+/* processor time spent in each phase of loading an instance, in seconds,
+ * as measured by clock() */
+struct load_times
+{
+	double parse;
+	double tests;
+	double vehicles;
+	double rehits;
+};
+
+typedef struct load_times LOADTIMES;
+
+/* parses the instance file once and fills tests, vehicles and the rehit
+ * matrix of inst; returns 0 on success and -1 if the file cannot be read or
+ * memory runs short */
 extern int
-get_vehicle_size(const char* path);
-
-
-extern void 
-read_in_tests(const char* path, TEST *testArr);
-
-extern void 
-read_in_vehicles(const char* path, VEHICLE *vehicleArr);
+read_in_instance(const char* path, INSTANCE* inst, LOADTIMES* times);
 
+/* frees the arrays allocated by read_in_instance and drops its reference
+ * to the rehit matrix */
 extern void
-read_in_rehit_rules(const char* path, int **rule);
+free_instance(INSTANCE* inst);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,561 @@
+#include "json_stream.h"
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STREAM_BUFSIZE		65536
+#define STREAM_MAXSTR		64
+#define STREAM_MAXTESTID	(1 << 28)	/* the id remap has one entry per id up to the largest */
+
+/* token kinds of the tokenizer, punctuation is returned as its character */
+enum token_kind
+{
+	TOK_EOF = 0,
+	TOK_ERROR = 1,
+	TOK_STRING = 2,
+	TOK_NUMBER = 3,
+	TOK_TRUE = 4,
+	TOK_FALSE = 5,
+	TOK_NULL = 6
+};
+
+/* buffered input and the current token */
+struct json_stream
+{
+	FILE*	file;
+	char	buf[STREAM_BUFSIZE];
+	size_t	pos;
+	size_t	len;
+	int		line;
+
+	int		tok;
+	char	str[STREAM_MAXSTR];		/* string token, truncated if longer */
+	long	num;					/* integral part of a number token */
+};
+
+typedef struct json_stream STREAM;
+
+// function prototypes
+static int stream_getc(STREAM *s);
+static int stream_peekc(STREAM *s);
+static int stream_next(STREAM *s);
+static int stream_expect(STREAM *s, int tok);
+static int stream_skip_value(STREAM *s);
+static int stream_read_tests(STREAM *s, INSTANCE *inst, int **testIds);
+static int stream_read_vehicles(STREAM *s, INSTANCE *inst);
+static int stream_read_rehits(STREAM *s, INSTANCE *inst, const int *id_remap, int max_test_id);
+static int stream_scan(STREAM *s, INSTANCE *inst, int **testIds, const int *id_remap, int max_test_id, LOADTIMES *times);
+
+int read_in_instance_stream(const char* path, INSTANCE* inst, LOADTIMES* times)
+{
+	STREAM *s;
+	clock_t start;
+	int *testIds;
+	int i;
+
+	assert(inst != NULL);
+	assert(times != NULL);
+
+	inst->tests = NULL;
+	inst->vehicles = NULL;
+	inst->rehits = NULL;
+	inst->idRemap = NULL;
+	inst->numTests = 0;
+	inst->numVehicles = 0;
+	inst->maxTestId = -1;
+
+	times->parse = 0.0;
+	times->tests = 0.0;
+	times->vehicles = 0.0;
+	times->rehits = 0.0;
+
+	s = (STREAM*) malloc(sizeof(STREAM));
+	if (s == NULL)
+	{
+		fprintf(stderr, "%s: out of memory\n", path);
+		return -1;
+	}
+	s->file = fopen(path, "rb");
+	if (s->file == NULL)
+	{
+		fprintf(stderr, "%s: cannot open file\n", path);
+		free(s);
+		return -1;
+	}
+
+	start = clock();
+
+	/* the rehit keys are test ids of the file, which can only be remapped
+	 * once all tests are known, so the first pass reads tests and vehicles
+	 * and the second pass only the rehit rules */
+	s->pos = s->len = 0;
+	s->line = 1;
+	testIds = NULL;
+	if (stream_scan(s, inst, &testIds, NULL, -1, times) != 0)
+	{
+		goto ERROR;
+	}
+
+	for (i = 0; i < inst->numTests; ++i)
+	{
+		if (testIds[i] > inst->maxTestId)
+			inst->maxTestId = testIds[i];
+	}
+
+	inst->idRemap = (int*) malloc((inst->maxTestId + 1) * sizeof(int));
+	if (inst->idRemap == NULL && inst->maxTestId >= 0)
+	{
+		goto ERROR;
+	}
+	for (i = 0; i <= inst->maxTestId; ++i)
+	{
+		inst->idRemap[i] = -1;
+	}
+	for (i = 0; i < inst->numTests; ++i)
+	{
+		if (testIds[i] >= 0)
+			inst->idRemap[testIds[i]] = i;
+	}
+	free(testIds);
+	testIds = NULL;
+
+	// pairs not listed in the file are not allowed
+	inst->rehits = bitmatrix_create(inst->numTests, inst->numTests);
+	if (inst->rehits == NULL)
+	{
+		goto ERROR;
+	}
+
+	rewind(s->file);
+	s->pos = s->len = 0;
+	s->line = 1;
+	if (stream_scan(s, inst, NULL, inst->idRemap, inst->maxTestId, times) != 0)
+	{
+		goto ERROR;
+	}
+
+	/* whatever was not spent inside one of the sections went into tokenizing the rest */
+	times->parse = (double) (clock() - start) / CLOCKS_PER_SEC - times->tests - times->vehicles - times->rehits;
+
+	fclose(s->file);
+	free(s);
+
+	return 0;
+
+ERROR:
+	fprintf(stderr, "%s:%d: malformed tp3s file, test id too large or out of memory\n", path, s->line);
+	free(testIds);
+	free_instance(inst);
+	fclose(s->file);
+	free(s);
+
+	return -1;
+}
+
+static
+int stream_getc(STREAM *s)
+{
+	if (s->pos == s->len)
+	{
+		s->len = fread(s->buf, 1, STREAM_BUFSIZE, s->file);
+		s->pos = 0;
+		if (s->len == 0)
+			return EOF;
+	}
+
+	return (unsigned char) s->buf[s->pos++];
+}
+
+static
+int stream_peekc(STREAM *s)
+{
+	int c;
+
+	c = stream_getc(s);
+	if (c != EOF)
+		s->pos--;
+
+	return c;
+}
+
+/* reads the next token into s->tok, returns it */
+static
+int stream_next(STREAM *s)
+{
+	int c;
+
+	do
+	{
+		c = stream_getc(s);
+		if (c == '\n')
+			s->line++;
+	}
+	while (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+
+	switch (c)
+	{
+	case EOF:
+		s->tok = TOK_EOF;
+		break;
+
+	case '{': case '}': case '[': case ']': case ':': case ',':
+		s->tok = c;
+		break;
+
+	case '"':
+	{
+		size_t n = 0;
+
+		while ((c = stream_getc(s)) != '"')
+		{
+			if (c == EOF)
+				return s->tok = TOK_ERROR;
+			if (c == '\\')
+			{
+				// escapes never occur in keys we look at, keep the escaped character
+				c = stream_getc(s);
+				if (c == EOF)
+					return s->tok = TOK_ERROR;
+			}
+			if (n < STREAM_MAXSTR - 1)
+				s->str[n++] = (char) c;
+		}
+		s->str[n] = '\0';
+		s->tok = TOK_STRING;
+		break;
+	}
+
+	case 't': case 'f': case 'n':
+	{
+		const char *word = (c == 't') ? "rue" : (c == 'f') ? "alse" : "ull";
+
+		for (; *word != '\0'; ++word)
+		{
+			if (stream_getc(s) != *word)
+				return s->tok = TOK_ERROR;
+		}
+		s->tok = (c == 't') ? TOK_TRUE : (c == 'f') ? TOK_FALSE : TOK_NULL;
+		break;
+	}
+
+	default:
+		if (c == '-' || (c >= '0' && c <= '9'))
+		{
+			int neg = (c == '-');
+
+			s->num = neg ? 0 : c - '0';
+			while ((c = stream_peekc(s)) >= '0' && c <= '9')
+			{
+				s->num = 10 * s->num + (stream_getc(s) - '0');
+				// every number ends up in an int, stop before the accumulator overflows
+				if (s->num > INT_MAX)
+					return s->tok = TOK_ERROR;
+			}
+			// only the integral part is of interest, drop fraction and exponent
+			while (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-' || (c >= '0' && c <= '9'))
+			{
+				stream_getc(s);
+				c = stream_peekc(s);
+			}
+			if (neg)
+				s->num = -s->num;
+			s->tok = TOK_NUMBER;
+		}
+		else
+			s->tok = TOK_ERROR;
+		break;
+	}
+
+	return s->tok;
+}
+
+static
+int stream_expect(STREAM *s, int tok)
+{
+	return stream_next(s) == tok ? 0 : -1;
+}
+
+/* skips the value whose first token is the current token */
+static
+int stream_skip_value(STREAM *s)
+{
+	int depth = 0;
+
+	do
+	{
+		switch (s->tok)
+		{
+		case '{': case '[':
+			depth++;
+			break;
+		case '}': case ']':
+			depth--;
+			break;
+		case TOK_EOF: case TOK_ERROR:
+			return -1;
+		default:
+			break;
+		}
+
+		if (depth > 0)
+			stream_next(s);
+	}
+	while (depth > 0);
+
+	return 0;
+}
+
+/* reads the tests array, the current token is its '[' */
+static
+int stream_read_tests(STREAM *s, INSTANCE *inst, int **testIds)
+{
+	int size = 0;
+
+	if (s->tok != '[')
+		return -1;
+
+	if (stream_next(s) == ']')
+		return 0;
+
+	while (1)
+	{
+		TEST test;
+		int tid = -1;
+
+		if (s->tok != '{')
+			return -1;
+
+		memset(&test, 0, sizeof(TEST));
+		stream_next(s);
+		while (s->tok == TOK_STRING)
+		{
+			char key[STREAM_MAXSTR];
+
+			strcpy(key, s->str);
+			if (stream_expect(s, ':') != 0)
+				return -1;
+			stream_next(s);
+
+			if (s->tok == TOK_NUMBER && strcmp(key, "test_id") == 0)
+			{
+				if (s->num > STREAM_MAXTESTID)
+					return -1;
+				tid = (int) s->num;
+			}
+			else if (s->tok == TOK_NUMBER && strcmp(key, "dur") == 0)
+				test.dur = s->num;
+			else if (s->tok == TOK_NUMBER && strcmp(key, "release") == 0)
+				test.release = s->num;
+			else if (s->tok == TOK_NUMBER && strcmp(key, "deadline") == 0)
+				test.deadline = s->num;
+			else if (stream_skip_value(s) != 0)
+				return -1;
+
+			if (stream_next(s) == ',')
+				stream_next(s);
+		}
+		if (s->tok != '}')
+			return -1;
+
+		if (inst->numTests == size)
+		{
+			TEST* tests;
+			int* ids;
+
+			size = size == 0 ? 64 : 2 * size;
+			tests = (TEST*) realloc(inst->tests, size * sizeof(TEST));
+			if (tests == NULL)
+				return -1;
+			inst->tests = tests;
+			ids = (int*) realloc(*testIds, size * sizeof(int));
+			if (ids == NULL)
+				return -1;
+			*testIds = ids;
+		}
+		test.tid = inst->numTests;
+		inst->tests[inst->numTests] = test;
+		(*testIds)[inst->numTests] = tid;
+		inst->numTests++;
+
+		stream_next(s);
+		if (s->tok == ']')
+			break;
+		if (s->tok != ',')
+			return -1;
+		stream_next(s);
+	}
+
+	return 0;
+}
+
+/* reads the vehicles array, the current token is its '[' */
+static
+int stream_read_vehicles(STREAM *s, INSTANCE *inst)
+{
+	int size = 0;
+
+	if (s->tok != '[')
+		return -1;
+
+	if (stream_next(s) == ']')
+		return 0;
+
+	while (1)
+	{
+		VEHICLE vehicle;
+
+		if (s->tok != '{')
+			return -1;
+
+		memset(&vehicle, 0, sizeof(VEHICLE));
+		stream_next(s);
+		while (s->tok == TOK_STRING)
+		{
+			char key[STREAM_MAXSTR];
+
+			strcpy(key, s->str);
+			if (stream_expect(s, ':') != 0)
+				return -1;
+			stream_next(s);
+
+			if (s->tok == TOK_NUMBER && strcmp(key, "vehicle_id") == 0)
+				vehicle.vid = s->num;
+			else if (s->tok == TOK_NUMBER && strcmp(key, "release") == 0)
+				vehicle.release = s->num;
+			else if (stream_skip_value(s) != 0)
+				return -1;
+
+			if (stream_next(s) == ',')
+				stream_next(s);
+		}
+		if (s->tok != '}')
+			return -1;
+
+		if (inst->numVehicles == size)
+		{
+			VEHICLE* vehicles;
+
+			size = size == 0 ? 64 : 2 * size;
+			vehicles = (VEHICLE*) realloc(inst->vehicles, size * sizeof(VEHICLE));
+			if (vehicles == NULL)
+				return -1;
+			inst->vehicles = vehicles;
+		}
+		inst->vehicles[inst->numVehicles++] = vehicle;
+
+		stream_next(s);
+		if (s->tok == ']')
+			break;
+		if (s->tok != ',')
+			return -1;
+		stream_next(s);
+	}
+
+	return 0;
+}
+
+/* reads the nested rehit object, the current token is its '{' */
+static
+int stream_read_rehits(STREAM *s, INSTANCE *inst, const int *id_remap, int max_test_id)
+{
+	if (s->tok != '{')
+		return -1;
+
+	stream_next(s);
+	while (s->tok == TOK_STRING)
+	{
+		int id1, real_id1;
+
+		id1 = atoi(s->str);
+		real_id1 = (id1 >= 0 && id1 <= max_test_id) ? id_remap[id1] : -1;
+
+		if (stream_expect(s, ':') != 0 || stream_expect(s, '{') != 0)
+			return -1;
+
+		stream_next(s);
+		while (s->tok == TOK_STRING)
+		{
+			int id2, real_id2;
+
+			id2 = atoi(s->str);
+			real_id2 = (id2 >= 0 && id2 <= max_test_id) ? id_remap[id2] : -1;
+
+			if (stream_expect(s, ':') != 0)
+				return -1;
+			stream_next(s);
+
+			if (real_id1 >= 0 && real_id2 >= 0)
+			{
+				assert(real_id1 < inst->numTests);
+				assert(real_id2 < inst->numTests);
+
+				// write the rule
+				bitmatrix_set(inst->rehits, real_id1, real_id2, s->tok == TOK_TRUE);
+			}
+
+			if (stream_skip_value(s) != 0)
+				return -1;
+			if (stream_next(s) == ',')
+				stream_next(s);
+		}
+		if (s->tok != '}')
+			return -1;
+
+		if (stream_next(s) == ',')
+			stream_next(s);
+	}
+
+	return s->tok == '}' ? 0 : -1;
+}
+
+/* walks the top level object once; with testIds given, tests and vehicles
+ * are read and rehit is skipped, otherwise only rehit is read */
+static
+int stream_scan(STREAM *s, INSTANCE *inst, int **testIds, const int *id_remap, int max_test_id, LOADTIMES *times)
+{
+	if (stream_expect(s, '{') != 0)
+		return -1;
+
+	stream_next(s);
+	while (s->tok == TOK_STRING)
+	{
+		char key[STREAM_MAXSTR];
+		clock_t start;
+		int retcode;
+
+		strcpy(key, s->str);
+		if (stream_expect(s, ':') != 0)
+			return -1;
+		stream_next(s);
+
+		start = clock();
+		if (testIds != NULL && strcmp(key, "tests") == 0)
+		{
+			retcode = stream_read_tests(s, inst, testIds);
+			times->tests += (double) (clock() - start) / CLOCKS_PER_SEC;
+		}
+		else if (testIds != NULL && strcmp(key, "vehicles") == 0)
+		{
+			retcode = stream_read_vehicles(s, inst);
+			times->vehicles += (double) (clock() - start) / CLOCKS_PER_SEC;
+		}
+		else if (testIds == NULL && strcmp(key, "rehit") == 0)
+		{
+			retcode = stream_read_rehits(s, inst, id_remap, max_test_id);
+			times->rehits += (double) (clock() - start) / CLOCKS_PER_SEC;
+		}
+		else
+			retcode = stream_skip_value(s);
+
+		if (retcode != 0)
+			return -1;
+
+		if (stream_next(s) == ',')
+			stream_next(s);
+	}
+
+	return s->tok == '}' ? 0 : -1;
+}
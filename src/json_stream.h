@@ -0,0 +1,14 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include "data_structure.h"
+#include "json_read.h"
+
+/* reads the instance with a streaming tokenizer instead of building the
+ * json tree; tests, vehicles and rehit entries are written straight into
+ * the arrays of inst, so peak memory stays close to the size of the
+ * output. returns 0 on success and -1 if the file cannot be read */
+extern int
+read_in_instance_stream(const char* path, INSTANCE* inst, LOADTIMES* times);
+
+#endif
@@ -0,0 +1,908 @@
+#include "labeling.h"
+#include "schedule.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LABEL_EPS		1e-9
+
+/* all labels of a run in structure of arrays layout. a label is a partial
+ * sequence ending in test last; its unreachable set holds the visited tests
+ * and all tests some visited test forbids as a successor, its pending set
+ * the partners of visited tests that still have to be served */
+struct label_store
+{
+	int*			last;
+	int*			time;			/* completion time of last */
+	int*			cost;			/* tardiness so far */
+	int*			len;
+	int*			pred;			/* index of the label this one extends, -1 for a start */
+	double*			redcost;		/* cost minus the duals of the visited tests */
+	unsigned char*	alive;			/* cleared when a later label dominates this one */
+	uint64_t*		unreach;		/* nwords words per label */
+	uint64_t*		pending;		/* nwords words per label, NULL if the problem has no partners */
+	int				nlabels;
+	int				size;
+	int				nwords;
+
+	/* labels to extend, bucketed by completion time; bucket b holds the
+	 * times basetime + b * width .. basetime + (b+1) * width - 1 */
+	int**			buckets;
+	int*			nbucket;
+	int*			sizebucket;
+	int				nbuckets;
+	int				basetime;
+	int				width;
+
+	/* dominance candidates per last test; time and reduced cost are copied
+	 * next to the label index so that a scan stays within three arrays */
+	int**			domidx;
+	int**			domtime;
+	double**		domred;
+	int*			ndom;
+	int*			sizedom;
+	int				numTests;
+
+	long			ndominated;
+};
+
+typedef struct label_store STORE;
+
+// function prototypes
+static int store_init(STORE *store, int numTests, int nwords, int basetime, int width, int haspending);
+static void store_free(STORE *store);
+static int grow_list(void **list, int *size, int need, size_t elemsize);
+static int store_push(STORE *store, int last, int time, int cost, int len, int pred, double redcost, const uint64_t *unreach,
+	const uint64_t *pending);
+static int mask_subset(const uint64_t *a, const uint64_t *b, int nwords);
+static int insert_label(STORE *store, int last, int time, int cost, int len, int pred, double redcost, const uint64_t *unreach,
+	const uint64_t *pending, int maxpertest);
+static int extend_pending(const LABELPROB *prob, const uint64_t *frompending, int j, const uint64_t *unreach,
+	uint64_t *pending);
+static void record_column(const LABELPROB *prob, const STORE *store, int last, int cost, int len, int pred,
+	double labelredcost, double threshold, LABELRESULT *result);
+static void offer_column(LABELRESULT *result, const int *seq, int len, int cost, double redcost, int nwords);
+static int greedy_allowed(const LABELPROB *prob, int i);
+static int best_neighbors(const LABELPROB *prob, const uint64_t *reach, int time, int k, int *cand, double *key);
+
+LABELRESULT* labeling_result_create(int maxcols, int numTests)
+{
+	LABELRESULT *result;
+	int nwords = bitset_nwords(numTests);
+	int c;
+
+	assert(maxcols >= 1);
+
+	result = (LABELRESULT*) malloc(sizeof(LABELRESULT));
+	if (result == NULL)
+		return NULL;
+
+	result->cols = (LABELCOLUMN*) malloc(maxcols * sizeof(LABELCOLUMN));
+	// one more row than columns, used to assemble a candidate
+	result->seqmem = (int*) malloc((size_t) (maxcols + 1) * (numTests + 1) * sizeof(int));
+	result->setmem = (uint64_t*) malloc((size_t) (maxcols + 1) * (nwords + 1) * sizeof(uint64_t));
+	if (result->cols == NULL || result->seqmem == NULL || result->setmem == NULL)
+	{
+		free(result->setmem);
+		free(result->seqmem);
+		free(result->cols);
+		free(result);
+		return NULL;
+	}
+
+	result->maxcols = maxcols;
+	result->numTests = numTests;
+	result->ncols = 0;
+	result->complete = 1;
+	result->bestredcost = 0.0;
+	result->nlabels = 0;
+	result->ndominated = 0;
+	result->nextended = 0;
+
+	for (c = 0; c < maxcols; ++c)
+	{
+		result->cols[c].tests = result->seqmem + (size_t) c * (numTests + 1);
+		result->cols[c].visited = result->setmem + (size_t) c * (nwords + 1);
+	}
+
+	return result;
+}
+
+void labeling_result_free(LABELRESULT** result)
+{
+	assert(result != NULL);
+
+	if (*result == NULL)
+		return;
+
+	free((*result)->setmem);
+	free((*result)->seqmem);
+	free((*result)->cols);
+	free(*result);
+	*result = NULL;
+}
+
+int labeling_solve(const LABELPROB* prob, const LABELLIMITS* limits, double threshold, LABELRESULT* result)
+{
+	LABELLIMITS nolimits = { -1, 0, 0 };
+	STORE store;
+	uint64_t *unreach;
+	uint64_t *reach;
+	uint64_t *pending;
+	int *cand;
+	double *key;
+	int nwords;
+	int mindur;
+	int stop;
+	int b, i, w;
+
+	assert(prob != NULL);
+	assert(result != NULL);
+	assert(result->numTests == prob->numTests);
+
+	if (limits == NULL)
+		limits = &nolimits;
+
+	nwords = prob->rehits->nwords;
+
+	result->ncols = 0;
+	result->complete = 1;
+	result->bestredcost = 0.0;
+	result->nlabels = 0;
+	result->ndominated = 0;
+	result->nextended = 0;
+
+	/* with buckets as wide as the shortest test an extension always lands in
+	 * a later bucket, so each bucket is complete once it is reached */
+	mindur = 0;
+	for (i = 0; i < prob->numTests; ++i)
+	{
+		if (i == 0 || (int) prob->tests[i].dur < mindur)
+			mindur = (int) prob->tests[i].dur;
+	}
+
+	if (store_init(&store, prob->numTests, nwords, prob->release, mindur > 1 ? mindur : 1, prob->partners != NULL) != 0)
+		return -1;
+
+	unreach = (uint64_t*) malloc((3 * nwords + 1) * sizeof(uint64_t));
+	cand = (int*) malloc((prob->numTests + 1) * sizeof(int));
+	key = (double*) malloc((prob->numTests + 1) * sizeof(double));
+	if (unreach == NULL || cand == NULL || key == NULL)
+		goto NOMEMORY;
+	reach = unreach + nwords;
+	pending = reach + nwords;
+
+	/* one start label per test the vehicle may serve; the forbidden tests
+	 * stay unreachable for all extensions */
+	for (i = 0; i < prob->numTests; ++i)
+	{
+		const TEST *test = &prob->tests[i];
+		const uint64_t *row = bitmatrix_row(prob->rehits, i);
+		int time = test_completion(test, prob->release);
+		int cost = test_tardiness(test, time);
+		double redcost = prob->costWeight * cost - prob->testDuals[i];
+		int open = 0;
+
+		if (prob->forbidden != NULL && bitset_get(prob->forbidden, i))
+			continue;
+
+		for (w = 0; w < nwords; ++w)
+			unreach[w] = ~row[w] | (prob->forbidden != NULL ? prob->forbidden[w] : 0);
+		bitset_set(unreach, i);
+
+		if (store.pending != NULL && (open = extend_pending(prob, NULL, i, unreach, pending)) < 0)
+			continue;
+
+		if (!open)
+			record_column(prob, &store, i, cost, 1, -1, redcost, threshold, result);
+		if (insert_label(&store, i, time, cost, 1, -1, redcost, unreach, store.pending != NULL ? pending : NULL, 0) == -2)
+			goto NOMEMORY;
+	}
+
+	/* the labels are extended in order of completion time */
+	stop = 0;
+	for (b = 0; b < store.nbuckets && !stop; ++b)
+	{
+		int k;
+
+		for (k = 0; k < store.nbucket[b] && !stop; ++k)
+		{
+			int q = store.buckets[b][k];
+			const uint64_t *fromunreach;
+			int ncand;
+			int c;
+
+			// lazily dropped: dominated after it was queued
+			if (!store.alive[q])
+				continue;
+
+			fromunreach = store.unreach + (size_t) q * nwords;
+			for (w = 0; w < nwords; ++w)
+				reach[w] = ~fromunreach[w];
+
+			/* the successors to try: all reachable tests or the best few of them */
+			if (limits->neighbors > 0)
+			{
+				ncand = best_neighbors(prob, reach, store.time[q], limits->neighbors, cand, key);
+				if (ncand == limits->neighbors && bitset_popcount(reach, nwords) > ncand)
+					result->complete = 0;
+			}
+			else
+			{
+				ncand = 0;
+				for (i = bitset_next(reach, nwords, 0); i >= 0; i = bitset_next(reach, nwords, i + 1))
+					cand[ncand++] = i;
+			}
+
+			result->nextended++;
+
+			for (c = 0; c < ncand; ++c)
+			{
+				int j = cand[c];
+				const TEST *test = &prob->tests[j];
+				const uint64_t *row = bitmatrix_row(prob->rehits, j);
+				int time, cost;
+				double redcost;
+				int open = 0;
+				int idx;
+
+				if (limits->maxlabels >= 0 && store.nlabels >= limits->maxlabels)
+				{
+					result->complete = 0;
+					stop = 1;
+					break;
+				}
+
+				// the arrays may move while labels are added
+				fromunreach = store.unreach + (size_t) q * nwords;
+
+				time = test_completion(test, store.time[q]);
+				cost = store.cost[q] + test_tardiness(test, time);
+				redcost = store.redcost[q] + prob->costWeight * (cost - store.cost[q]) - prob->testDuals[j];
+
+				for (w = 0; w < nwords; ++w)
+					unreach[w] = fromunreach[w] | ~row[w];
+				bitset_set(unreach, j);
+
+				// a label that can no longer serve all partners of its tests is dropped
+				if (store.pending != NULL
+					&& (open = extend_pending(prob, store.pending + (size_t) q * nwords, j, unreach, pending)) < 0)
+					continue;
+
+				// a dominated label may still be the better column, so it is offered first
+				if (!open)
+					record_column(prob, &store, j, cost, store.len[q] + 1, q, redcost, threshold, result);
+				idx = insert_label(&store, j, time, cost, store.len[q] + 1, q, redcost, unreach,
+					store.pending != NULL ? pending : NULL, limits->maxpertest);
+				if (idx == -2)
+					goto NOMEMORY;
+				if (idx == -3)
+					result->complete = 0;
+			}
+		}
+	}
+
+	result->nlabels = store.nlabels;
+	result->ndominated = store.ndominated;
+
+	free(key);
+	free(cand);
+	free(unreach);
+	store_free(&store);
+
+	return 0;
+
+NOMEMORY:
+	free(key);
+	free(cand);
+	free(unreach);
+	store_free(&store);
+
+	return -1;
+}
+
+int labeling_greedy(const LABELPROB* prob, double threshold, LABELRESULT* result)
+{
+	int nwords = prob->rehits->nwords;
+	uint64_t *allowed;
+	int *seq;
+	int *trial;
+	int i;
+
+	assert(prob != NULL);
+	assert(result != NULL);
+	assert(result->numTests == prob->numTests);
+
+	result->ncols = 0;
+	result->complete = 0;
+	result->bestredcost = 0.0;
+	result->nlabels = 0;
+	result->ndominated = 0;
+	result->nextended = 0;
+
+	seq = (int*) malloc(2 * (prob->numTests + 1) * sizeof(int));
+	allowed = (uint64_t*) malloc((nwords + 1) * sizeof(uint64_t));
+	if (seq == NULL || allowed == NULL)
+	{
+		free(allowed);
+		free(seq);
+		return -1;
+	}
+	trial = seq + prob->numTests + 1;
+
+	for (i = 0; i < prob->numTests; ++i)
+	{
+		double redcost;
+		int cost;
+		int len;
+
+		if (!greedy_allowed(prob, i))
+			continue;
+
+		seq[0] = i;
+		len = 1;
+		cost = sequence_cost(prob->tests, seq, 1, prob->release);
+		redcost = prob->costWeight * cost - prob->testDuals[i] - prob->vehicleDual;
+
+		/* insert tests while the reduced cost drops */
+		for (;;)
+		{
+			double bestredcost = redcost;
+			int bestcost = cost;
+			int bestj = -1;
+			int bestpos = -1;
+			int j, p, w;
+
+			// tests every test of the sequence allows as a successor
+			for (w = 0; w < nwords; ++w)
+				allowed[w] = ~(uint64_t) 0;
+			for (p = 0; p < len; ++p)
+				bitset_and(allowed, allowed, bitmatrix_row(prob->rehits, seq[p]), nwords);
+			for (p = 0; p < len; ++p)
+				bitset_clear(allowed, seq[p]);
+
+			/* test j at position p needs the rules of seq[0..p-1] and must allow seq[p..len-1] */
+			for (j = 0; j < prob->numTests; ++j)
+			{
+				const uint64_t *row = bitmatrix_row(prob->rehits, j);
+				int k;
+
+				for (k = 0; k < len && seq[k] != j; ++k)
+					;
+				if (k < len || !greedy_allowed(prob, j))
+					continue;
+
+				for (p = len; p >= 0; --p)
+				{
+					double trialredcost;
+					int trialcost;
+
+					// placing j earlier also needs j to allow the tests behind it
+					if (p < len && !bitset_get(row, seq[p]))
+						break;
+
+					if (p == len && !bitset_get(allowed, j))
+						continue;
+					if (p < len)
+					{
+						int ok = 1;
+
+						for (k = 0; k < p && ok; ++k)
+							ok = bitmatrix_get(prob->rehits, seq[k], j);
+						if (!ok)
+							continue;
+					}
+
+					memcpy(trial, seq, p * sizeof(int));
+					trial[p] = j;
+					memcpy(trial + p + 1, seq + p, (len - p) * sizeof(int));
+
+					trialcost = sequence_cost(prob->tests, trial, len + 1, prob->release);
+					trialredcost = redcost + prob->costWeight * (trialcost - cost) - prob->testDuals[j];
+
+					if (trialredcost < bestredcost - LABEL_EPS)
+					{
+						bestredcost = trialredcost;
+						bestcost = trialcost;
+						bestj = j;
+						bestpos = p;
+					}
+				}
+			}
+
+			if (bestj < 0)
+				break;
+
+			memmove(seq + bestpos + 1, seq + bestpos, (len - bestpos) * sizeof(int));
+			seq[bestpos] = bestj;
+			len++;
+			cost = bestcost;
+			redcost = bestredcost;
+			result->nextended++;
+		}
+
+		if (redcost < result->bestredcost)
+			result->bestredcost = redcost;
+
+		if (redcost < threshold)
+			offer_column(result, seq, len, cost, redcost, nwords);
+	}
+
+	free(allowed);
+	free(seq);
+
+	return 0;
+}
+
+static
+int store_init(STORE *store, int numTests, int nwords, int basetime, int width, int haspending)
+{
+	memset(store, 0, sizeof(STORE));
+
+	store->size = 1024;
+	store->nwords = nwords;
+	store->numTests = numTests;
+	store->basetime = basetime;
+	store->width = width;
+
+	store->last = (int*) malloc(store->size * sizeof(int));
+	store->time = (int*) malloc(store->size * sizeof(int));
+	store->cost = (int*) malloc(store->size * sizeof(int));
+	store->len = (int*) malloc(store->size * sizeof(int));
+	store->pred = (int*) malloc(store->size * sizeof(int));
+	store->redcost = (double*) malloc(store->size * sizeof(double));
+	store->alive = (unsigned char*) malloc(store->size);
+	store->unreach = (uint64_t*) malloc((size_t) store->size * nwords * sizeof(uint64_t) + sizeof(uint64_t));
+	if (haspending)
+	{
+		store->pending = (uint64_t*) malloc((size_t) store->size * nwords * sizeof(uint64_t) + sizeof(uint64_t));
+		if (store->pending == NULL)
+		{
+			store_free(store);
+			return -1;
+		}
+	}
+
+	store->domidx = (int**) calloc(numTests + 1, sizeof(int*));
+	store->domtime = (int**) calloc(numTests + 1, sizeof(int*));
+	store->domred = (double**) calloc(numTests + 1, sizeof(double*));
+	store->ndom = (int*) calloc(numTests + 1, sizeof(int));
+	store->sizedom = (int*) calloc(numTests + 1, sizeof(int));
+
+	if (store->last == NULL || store->time == NULL || store->cost == NULL || store->len == NULL
+		|| store->pred == NULL || store->redcost == NULL || store->alive == NULL || store->unreach == NULL
+		|| store->domidx == NULL || store->domtime == NULL || store->domred == NULL
+		|| store->ndom == NULL || store->sizedom == NULL)
+	{
+		store_free(store);
+		return -1;
+	}
+
+	return 0;
+}
+
+static
+void store_free(STORE *store)
+{
+	int i;
+
+	for (i = 0; i < store->nbuckets; ++i)
+		free(store->buckets[i]);
+	free(store->sizebucket);
+	free(store->nbucket);
+	free(store->buckets);
+
+	if (store->domidx != NULL && store->domtime != NULL && store->domred != NULL)
+	{
+		for (i = 0; i < store->numTests; ++i)
+		{
+			free(store->domidx[i]);
+			free(store->domtime[i]);
+			free(store->domred[i]);
+		}
+	}
+	free(store->sizedom);
+	free(store->ndom);
+	free(store->domred);
+	free(store->domtime);
+	free(store->domidx);
+
+	free(store->pending);
+	free(store->unreach);
+	free(store->alive);
+	free(store->redcost);
+	free(store->pred);
+	free(store->len);
+	free(store->cost);
+	free(store->time);
+	free(store->last);
+}
+
+/* makes room for need elements in *list, doubling its size; returns -1 on
+ * memory shortage */
+static
+int grow_list(void **list, int *size, int need, size_t elemsize)
+{
+	void *grown;
+	int newsize = *size > 0 ? *size : 16;
+
+	if (need <= *size)
+		return 0;
+
+	while (newsize < need)
+		newsize *= 2;
+
+	grown = realloc(*list, (size_t) newsize * elemsize);
+	if (grown == NULL)
+		return -1;
+
+	*list = grown;
+	*size = newsize;
+
+	return 0;
+}
+
+/* appends a label to the label arrays, its bucket and its dominance list;
+ * returns its index or -1 on memory shortage */
+static
+int store_push(STORE *store, int last, int time, int cost, int len, int pred, double redcost, const uint64_t *unreach,
+	const uint64_t *pending)
+{
+	int idx = store->nlabels;
+	int b;
+
+	if (idx == store->size)
+	{
+		int size = store->size;
+
+		if (grow_list((void**) &store->last, &size, idx + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->time, &size, idx + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->cost, &size, idx + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->len, &size, idx + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->pred, &size, idx + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->redcost, &size, idx + 1, sizeof(double)) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->alive, &size, idx + 1, 1) != 0)
+			return -1;
+		size = store->size;
+		if (grow_list((void**) &store->unreach, &size, idx + 1, store->nwords * sizeof(uint64_t)) != 0)
+			return -1;
+		if (store->pending != NULL)
+		{
+			size = store->size;
+			if (grow_list((void**) &store->pending, &size, idx + 1, store->nwords * sizeof(uint64_t)) != 0)
+				return -1;
+		}
+		store->size = size;
+	}
+
+	b = (time - store->basetime) / store->width;
+	assert(b >= 0);
+
+	if (b >= store->nbuckets)
+	{
+		int nbuckets = store->nbuckets;
+		int size;
+		int i;
+
+		size = nbuckets;
+		if (grow_list((void**) &store->buckets, &size, b + 1, sizeof(int*)) != 0)
+			return -1;
+		size = nbuckets;
+		if (grow_list((void**) &store->nbucket, &size, b + 1, sizeof(int)) != 0)
+			return -1;
+		size = nbuckets;
+		if (grow_list((void**) &store->sizebucket, &size, b + 1, sizeof(int)) != 0)
+			return -1;
+
+		for (i = nbuckets; i < size; ++i)
+		{
+			store->buckets[i] = NULL;
+			store->nbucket[i] = 0;
+			store->sizebucket[i] = 0;
+		}
+		store->nbuckets = size;
+	}
+
+	if (store->nbucket[b] == store->sizebucket[b]
+		&& grow_list((void**) &store->buckets[b], &store->sizebucket[b], store->nbucket[b] + 1, sizeof(int)) != 0)
+		return -1;
+
+	if (store->ndom[last] == store->sizedom[last])
+	{
+		int size = store->sizedom[last];
+
+		if (grow_list((void**) &store->domidx[last], &size, store->ndom[last] + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->sizedom[last];
+		if (grow_list((void**) &store->domtime[last], &size, store->ndom[last] + 1, sizeof(int)) != 0)
+			return -1;
+		size = store->sizedom[last];
+		if (grow_list((void**) &store->domred[last], &size, store->ndom[last] + 1, sizeof(double)) != 0)
+			return -1;
+		store->sizedom[last] = size;
+	}
+
+	store->last[idx] = last;
+	store->time[idx] = time;
+	store->cost[idx] = cost;
+	store->len[idx] = len;
+	store->pred[idx] = pred;
+	store->redcost[idx] = redcost;
+	store->alive[idx] = 1;
+	memcpy(store->unreach + (size_t) idx * store->nwords, unreach, store->nwords * sizeof(uint64_t));
+	if (store->pending != NULL)
+		memcpy(store->pending + (size_t) idx * store->nwords, pending, store->nwords * sizeof(uint64_t));
+
+	store->buckets[b][store->nbucket[b]++] = idx;
+
+	store->domidx[last][store->ndom[last]] = idx;
+	store->domtime[last][store->ndom[last]] = time;
+	store->domred[last][store->ndom[last]] = redcost;
+	store->ndom[last]++;
+
+	store->nlabels++;
+
+	return idx;
+}
+
+/* is a a subset of b? the words are combined without an early exit so that
+ * the loop vectorizes */
+static
+int mask_subset(const uint64_t *a, const uint64_t *b, int nwords)
+{
+	uint64_t acc = 0;
+	int w;
+
+	for (w = 0; w < nwords; ++w)
+		acc |= a[w] & ~b[w];
+
+	return acc == 0;
+}
+
+/* stores the label unless a label with the same last test dominates it, and
+ * marks the stored labels it dominates as dead; dead labels are dropped from
+ * the dominance list during the scan and skipped when their bucket is
+ * processed. a dominates b if it completes no later, has no larger reduced
+ * cost and can reach every test b can reach, so every extension of b is
+ * feasible for a and at most as expensive; with partners both also need the
+ * same pending set. with maxpertest > 0 a label is
+ * also dropped if that many labels with its last test are alive. returns
+ * the index of the label, -1 if it is dominated, -2 on memory shortage and
+ * -3 if it was dropped by the limit */
+static
+int insert_label(STORE *store, int last, int time, int cost, int len, int pred, double redcost, const uint64_t *unreach,
+	const uint64_t *pending, int maxpertest)
+{
+	int *domidx = store->domidx[last];
+	int *domtime = store->domtime[last];
+	double *domred = store->domred[last];
+	int nwords = store->nwords;
+	int n = store->ndom[last];
+	int kept;
+	int k;
+
+	/* one pass that checks both directions and compacts the list */
+	kept = 0;
+	for (k = 0; k < n; ++k)
+	{
+		int other = domidx[k];
+		const uint64_t *otherunreach;
+
+		if (!store->alive[other])
+			continue;
+
+		otherunreach = store->unreach + (size_t) other * nwords;
+
+		// labels waiting for different partners complete in different ways
+		if (pending != NULL && memcmp(store->pending + (size_t) other * nwords, pending, nwords * sizeof(uint64_t)) != 0)
+		{
+			domidx[kept] = other;
+			domtime[kept] = domtime[k];
+			domred[kept] = domred[k];
+			kept++;
+			continue;
+		}
+
+		if (domtime[k] <= time && domred[k] <= redcost + LABEL_EPS && mask_subset(otherunreach, unreach, nwords))
+		{
+			// keep the rest of the list as it is
+			for (; k < n; ++k, ++kept)
+			{
+				domidx[kept] = domidx[k];
+				domtime[kept] = domtime[k];
+				domred[kept] = domred[k];
+			}
+			store->ndom[last] = kept;
+			store->ndominated++;
+
+			return -1;
+		}
+
+		if (time <= domtime[k] && redcost <= domred[k] + LABEL_EPS && mask_subset(unreach, otherunreach, nwords))
+		{
+			store->alive[other] = 0;
+			store->ndominated++;
+			continue;
+		}
+
+		domidx[kept] = other;
+		domtime[kept] = domtime[k];
+		domred[kept] = domred[k];
+		kept++;
+	}
+	store->ndom[last] = kept;
+
+	if (maxpertest > 0 && kept >= maxpertest)
+		return -3;
+
+	k = store_push(store, last, time, cost, len, pred, redcost, unreach, pending);
+
+	return k < 0 ? -2 : k;
+}
+
+/* sets pending to the partners still to be served once the label with
+ * pending set frompending (NULL for a start) is extended by test j; unreach
+ * is the unreachable set of the extension. returns -1 if one of them can no
+ * longer be reached, so that the label never becomes a column, and otherwise
+ * whether any partner is pending */
+static
+int extend_pending(const LABELPROB *prob, const uint64_t *frompending, int j, const uint64_t *unreach,
+	uint64_t *pending)
+{
+	const uint64_t *row = bitmatrix_row(prob->partners, j);
+	int nwords = prob->partners->nwords;
+	uint64_t open = 0;
+	uint64_t lost = 0;
+	int w;
+
+	/* the partners are closed under transitivity: if j was pending, its
+	 * partners are visited or pending already, otherwise none is visited */
+	if (frompending != NULL && bitset_get(frompending, j))
+		memcpy(pending, frompending, nwords * sizeof(uint64_t));
+	else
+	{
+		for (w = 0; w < nwords; ++w)
+			pending[w] = (frompending != NULL ? frompending[w] : 0) | row[w];
+	}
+	bitset_clear(pending, j);
+
+	for (w = 0; w < nwords; ++w)
+	{
+		open |= pending[w];
+		lost |= pending[w] & unreach[w];
+	}
+
+	if (lost != 0)
+		return -1;
+
+	return open != 0;
+}
+
+/* offers the sequence that extends label pred by last as a column to the
+ * result; pred is -1 for a single test */
+static
+void record_column(const LABELPROB *prob, const STORE *store, int last, int cost, int len, int pred,
+	double labelredcost, double threshold, LABELRESULT *result)
+{
+	int *seq = result->seqmem + (size_t) result->maxcols * (result->numTests + 1);
+	double redcost;
+	int k, l;
+
+	redcost = labelredcost + prob->costWeight * (len == 1 ? SINGLE_TEST_COST : 0) - prob->vehicleDual;
+
+	if (redcost < result->bestredcost)
+		result->bestredcost = redcost;
+
+	if (redcost >= threshold)
+		return;
+
+	seq[len - 1] = last;
+	for (k = len - 2, l = pred; k >= 0; --k, l = store->pred[l])
+		seq[k] = store->last[l];
+
+	offer_column(result, seq, len, cost + (len == 1 ? SINGLE_TEST_COST : 0), redcost, store->nwords);
+}
+
+/* keeps seq among the best columns of result; a column on the same set of
+ * tests is replaced only by a cheaper order */
+static
+void offer_column(LABELRESULT *result, const int *seq, int len, int cost, double redcost, int nwords)
+{
+	uint64_t *visited = result->setmem + (size_t) result->maxcols * (nwords + 1);
+	LABELCOLUMN *col;
+	int pos;
+	int c, k;
+
+	memset(visited, 0, nwords * sizeof(uint64_t));
+	for (k = 0; k < len; ++k)
+		bitset_set(visited, seq[k]);
+
+	/* find the slot: a column on the same tests, a free one, or the worst one */
+	pos = -1;
+	for (c = 0; c < result->ncols && pos < 0; ++c)
+	{
+		if (result->cols[c].ntests == len && memcmp(result->cols[c].visited, visited, nwords * sizeof(uint64_t)) == 0)
+		{
+			if (redcost >= result->cols[c].redcost)
+				return;
+			pos = c;
+		}
+	}
+
+	if (pos < 0 && result->ncols < result->maxcols)
+		pos = result->ncols++;
+
+	if (pos < 0)
+	{
+		pos = 0;
+		for (c = 1; c < result->ncols; ++c)
+		{
+			if (result->cols[c].redcost > result->cols[pos].redcost)
+				pos = c;
+		}
+		if (redcost >= result->cols[pos].redcost)
+			return;
+	}
+
+	col = &result->cols[pos];
+	col->redcost = redcost;
+	col->cost = cost;
+	col->ntests = len;
+	memcpy(col->tests, seq, len * sizeof(int));
+	memcpy(col->visited, visited, nwords * sizeof(uint64_t));
+}
+
+/* may greedy insertion use test i? it skips the forbidden tests and the
+ * tests with partners, which only the labeling serves together */
+static
+int greedy_allowed(const LABELPROB *prob, int i)
+{
+	if (prob->forbidden != NULL && bitset_get(prob->forbidden, i))
+		return 0;
+
+	return prob->partners == NULL || bitset_next(bitmatrix_row(prob->partners, i), prob->partners->nwords, 0) < 0;
+}
+
+/* selects the at most k tests of reach whose reduced cost increase after
+ * completing at time is smallest; returns their number, cand[0..] holds them */
+static
+int best_neighbors(const LABELPROB *prob, const uint64_t *reach, int time, int k, int *cand, double *key)
+{
+	int nwords = prob->rehits->nwords;
+	int n = 0;
+	int j;
+
+	for (j = bitset_next(reach, nwords, 0); j >= 0; j = bitset_next(reach, nwords, j + 1))
+	{
+		const TEST *test = &prob->tests[j];
+		double delta = prob->costWeight * test_tardiness(test, test_completion(test, time)) - prob->testDuals[j];
+		int pos;
+
+		if (n == k && delta >= key[n - 1])
+			continue;
+
+		// insertion into the sorted candidate list
+		pos = n < k ? n++ : n - 1;
+		for (; pos > 0 && key[pos - 1] > delta; --pos)
+		{
+			cand[pos] = cand[pos - 1];
+			key[pos] = key[pos - 1];
+		}
+		cand[pos] = j;
+		key[pos] = delta;
+	}
+
+	return n;
+}
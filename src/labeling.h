@@ -0,0 +1,96 @@
+#ifndef LABELING_H
+#define LABELING_H
+
+#include <stdint.h>
+
+#include "data_structure.h"
+#include "bitmatrix.h"
+
+/* the sequencing subproblem of one vehicle: find test sequences with
+ * negative reduced cost  w * cost(seq) - sum of test duals - vehicle dual,
+ * where consecutive and earlier tests must satisfy the rehit rules. the
+ * branching decisions of a node enter as forbidden successors in rehits,
+ * tests the vehicle must not serve and tests that must be served together */
+struct label_problem
+{
+	const TEST*			tests;
+	const BITMATRIX*	rehits;			/* rehits[i][j]: may test j follow test i */
+	const uint64_t*		forbidden;		/* tests the vehicle must not serve, NULL for none */
+	const BITMATRIX*	partners;		/* partners[i]: tests served whenever i is, closed under transitivity;
+										 * NULL for none */
+	const double*		testDuals;		/* dual value of the cover row of each test */
+	int					numTests;
+	int					release;		/* time the vehicle becomes available */
+	double				vehicleDual;
+	double				costWeight;		/* w: 1 with the duals of a feasible LP, 0 with
+										 * the Farkas duals of an infeasible one */
+};
+
+typedef struct label_problem LABELPROB;
+
+/* a column found by the labeling algorithm */
+struct label_column
+{
+	double		redcost;
+	int			cost;
+	int			ntests;
+	int*		tests;			/* the tests in the order they are served */
+	uint64_t*	visited;		/* the tests as a bitset, used to drop duplicates */
+};
+
+typedef struct label_column LABELCOLUMN;
+
+/* the best columns of one labeling run */
+struct label_result
+{
+	LABELCOLUMN*	cols;
+	int				ncols;
+	int				maxcols;
+	int				numTests;
+	int				complete;		/* was the search exhaustive, i.e. no label limit hit? */
+	double			bestredcost;	/* smallest reduced cost over all labels */
+	long			nlabels;		/* labels created in the last run */
+	long			ndominated;		/* labels rejected or removed by dominance */
+	long			nextended;		/* labels whose extensions were generated */
+	int*			seqmem;
+	uint64_t*		setmem;
+};
+
+typedef struct label_result LABELRESULT;
+
+/* limits of a labeling run; a run that hits one of them is heuristic */
+struct label_limits
+{
+	long		maxlabels;		/* labels created in total, < 0 for no limit */
+	int			maxpertest;		/* labels kept per last test, 0 for no limit */
+	int			neighbors;		/* a label is only extended by its best neighbors, 0 for all */
+};
+
+typedef struct label_limits LABELLIMITS;
+
+/* creates a result that keeps the maxcols best columns of a run, NULL if out
+ * of memory */
+extern LABELRESULT*
+labeling_result_create(int maxcols, int numTests);
+
+extern void
+labeling_result_free(LABELRESULT** result);
+
+/* solves prob by a resource constrained labeling algorithm over completion
+ * time, extending the labels bucket by bucket in order of completion; result
+ * receives the maxcols columns with the most negative reduced cost below
+ * threshold. limits may be NULL for an exact run; result->complete tells
+ * whether a limit cut the search. returns 0 on success and -1 on memory
+ * shortage */
+extern int
+labeling_solve(const LABELPROB* prob, const LABELLIMITS* limits, double threshold, LABELRESULT* result);
+
+/* builds one sequence per start test by cheapest feasible insertion of the
+ * test that lowers the reduced cost most, and offers it to result like
+ * labeling_solve; tests with partners are left to the labeling.
+ * result->complete is always 0. returns 0 on success and -1
+ * on memory shortage */
+extern int
+labeling_greedy(const LABELPROB* prob, double threshold, LABELRESULT* result);
+
+#endif
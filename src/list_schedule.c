@@ -0,0 +1,83 @@
+#include "list_schedule.h"
+#include "schedule.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+int list_schedule(const TEST* tests, const VEHICLE* vehicles, int numTests, int numVehicles, const BITMATRIX* rehits,
+	const int* order, int* seqs, int* lens)
+{
+	int nwords = rehits->nwords;
+	uint64_t *allowed;
+	int *avail;
+	int nleft = 0;
+	int k, v;
+
+	assert(tests != NULL);
+	assert(vehicles != NULL);
+	assert(order != NULL);
+
+	allowed = (uint64_t*) malloc(((size_t) numVehicles * nwords + 1) * sizeof(uint64_t));
+	avail = (int*) malloc((numVehicles + 1) * sizeof(int));
+	if (allowed == NULL || avail == NULL)
+	{
+		free(avail);
+		free(allowed);
+		return -1;
+	}
+
+	for (v = 0; v < numVehicles; ++v)
+	{
+		avail[v] = (int) vehicles[v].release;
+		lens[v] = 0;
+	}
+
+	for (k = 0; k < numTests; ++k)
+	{
+		int t = order[k];
+		int bestv = -1;
+		int bestdelta = 0;
+		int bestcompletion = 0;
+		uint64_t *row;
+
+		for (v = 0; v < numVehicles; ++v)
+		{
+			int completion;
+			int delta;
+
+			if (lens[v] > 0 && !bitset_get(allowed + (size_t) v * nwords, t))
+				continue;
+
+			completion = test_completion(&tests[t], avail[v]);
+			delta = test_tardiness(&tests[t], completion);
+
+			if (bestv < 0 || delta < bestdelta || (delta == bestdelta && completion < bestcompletion))
+			{
+				bestv = v;
+				bestdelta = delta;
+				bestcompletion = completion;
+			}
+		}
+
+		if (bestv < 0)
+		{
+			nleft++;
+			continue;
+		}
+
+		/* the tests that may still follow on the vehicle */
+		row = allowed + (size_t) bestv * nwords;
+		if (lens[bestv] == 0)
+			memcpy(row, bitmatrix_row(rehits, t), nwords * sizeof(uint64_t));
+		else
+			bitset_and(row, row, bitmatrix_row(rehits, t), nwords);
+
+		seqs[(size_t) bestv * numTests + lens[bestv]++] = t;
+		avail[bestv] = bestcompletion;
+	}
+
+	free(avail);
+	free(allowed);
+
+	return nleft;
+}
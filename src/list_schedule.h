@@ -0,0 +1,17 @@
+#ifndef LIST_SCHEDULE_H
+#define LIST_SCHEDULE_H
+
+#include "data_structure.h"
+#include "bitmatrix.h"
+
+/* list scheduling: the tests are assigned in the given order, each to the
+ * vehicle where it adds the least tardiness, ties to the one finishing it
+ * first, as long as the rehit rules allow it after every test already on
+ * that vehicle. seqs holds one row of numTests entries per vehicle and lens
+ * the length of each row; a test that fits on no vehicle is left out.
+ * returns the number of tests left out, or -1 on memory shortage */
+extern int
+list_schedule(const TEST* tests, const VEHICLE* vehicles, int numTests, int numVehicles, const BITMATRIX* rehits,
+	const int* order, int* seqs, int* lens);
+
+#endif
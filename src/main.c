@@ -4,6 +4,17 @@
 #include "scip/scipshell.h"
 #include "scip/scipdefplugins.h"
 
+#include "reader_tp3s.h"
+#include "reader_tp3b.h"
+#include "pricer_tp3s.h"
+#include "branch.h"
+#include "cons_samediff.h"
+#include "cons_testonvehicle.h"
+#include "cons_testorderonvehicle.h"
+#include "prop_decisions.h"
+#include "heur_listschedule.h"
+#include "heur_pricedive.h"
+
 
 static 
 SCIP_RETCODE runShell(
@@ -21,9 +32,22 @@ SCIP_RETCODE runShell(
 	/* include tp3s reader */
 	SCIP_CALL( SCIPincludeReaderTP3S(scip));
 
+	/* include reader for binary tp3b files */
+	SCIP_CALL( SCIPincludeReaderTP3B(scip));
+
 	/*include tp3s branching and branching data */
+	SCIP_CALL( SCIPincludeBranchrule(scip));
+	SCIP_CALL( SCIPincludeConshdlrSamediff(scip));
+	SCIP_CALL( SCIPincludeConshdlrTestOnVehicle(scip));
+	SCIP_CALL( SCIPincludeConshdlrTestOrderOnVehicle(scip));
+	SCIP_CALL( SCIPincludePropDecisions(scip));
 
 	/* include tp3s pricer */
+	SCIP_CALL( SCIPincludePricerTP3S(scip));
+
+	/* include list scheduling and price and dive heuristics */
+	SCIP_CALL( SCIPincludeHeurListSchedule(scip));
+	SCIP_CALL( SCIPincludeHeurPriceDive(scip));
 
 	/* include default plugins */
 	SCIP_CALL(SCIPincludeDefaultPlugins(scip));
@@ -1,14 +1,78 @@
 #include "pricer_tp3s.h"
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "labeling.h"
+#include "schedule.h"
+#include "thread_pool.h"
+#include "cons_samediff.h"
+#include "cons_testonvehicle.h"
+#include "cons_testorderonvehicle.h"
+#include "scip/cons_setppc.h"
+#include "scip/cons_linear.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <string.h>
 
 #define PRICER_NAME            "tp3s pricer"
 #define PRICER_DESC            "pricer for tp3s columns"
 #define PRICER_PRIORITY        0
 #define PRICER_DELAY           TRUE     /* only call pricer if all problem variables have non-negative reduced costs */
 
+#define DEFAULT_MAXCOLS        20       /**< maximal number of columns added per vehicle and pricing round */
+#define DEFAULT_MAXLABELS      -1LL     /**< maximal number of labels per labeling run, -1 for no limit */
+#define DEFAULT_STAGES         "gtre"   /**< pricing stages in the order they are tried */
+#define DEFAULT_MAXPERTEST     3        /**< labels kept per last test in truncated labeling */
+#define DEFAULT_NEIGHBORS      5        /**< successors tried per label in restricted labeling */
+#define DEFAULT_THREADS        1        /**< threads pricing the vehicles, 0 for one per core */
+#define DEFAULT_AGGREGATE      FALSE    /**< one capacity row per vehicle class instead of one row per vehicle */
+#define DEFAULT_LAZYCOLUMNS    FALSE    /**< seed the master with greedy and slack columns instead of all short ones */
+#define DEFAULT_NAMECOLUMNS    TRUE     /**< name the columns after their tests and vehicle */
+#define DEFAULT_MAXAGE         50       /**< pricing rounds out of the LP after which a column is deleted, -1 never */
+#define DEFAULT_POOLSIZE       10000    /**< deleted columns kept for repricing */
+#define DEFAULT_SMOOTHING      0.0      /**< weight of the stability center in the priced duals, 0 for none */
+#define DEFAULT_STOPEARLY      TRUE     /**< stop pricing at a node once the Lagrangian bound meets the LP value */
+
+/** stages of the pricing cascade, each one only runs if the ones before found no column */
+enum PricingStage
+{
+   STAGE_GREEDY     = 0,                /**< greedy insertion from every test */
+   STAGE_TRUNCATED  = 1,                /**< labeling that keeps few labels per last test */
+   STAGE_RESTRICTED = 2,                /**< labeling that only extends to the best neighbors */
+   STAGE_EXACT      = 3                 /**< labeling without limits */
+};
+typedef enum PricingStage PRICINGSTAGE;
+
+#define NSTAGES                4
+
+#define NODESTATES             64       /**< nodes whose pricing state is kept for their children */
+
+static const char stageChars[NSTAGES] = { 'g', 't', 'r', 'e' };
+static const char* stageNames[NSTAGES] = { "greedy", "truncated", "restricted", "exact" };
+
+/** one pricing stage for all vehicle classes, handed to the thread pool; each task only touches its own class'
+ *  buffer and never calls SCIP */
+struct PricingJob
+{
+   SCIP_PRICERDATA*      pricerdata;         /**< pricer data with the duals of the round */
+   PRICINGSTAGE          stage;              /**< stage to run */
+   LABELLIMITS           limits;             /**< limits of the labeling stages */
+   double                threshold;          /**< reduced cost a column must stay below */
+};
+typedef struct PricingJob PRICINGJOB;
+
+/** pricing state a node leaves to its children: its last LP duals and the columns of its last LP solution */
+struct NodeState
+{
+   SCIP_Longint          node;               /**< number of the node, -1 for an unused slot */
+   double*               testDuals;          /**< last duals of the test rows */
+   double*               vehicleDuals;       /**< last duals of the vehicle rows */
+   SCIP_VARDATA**        cols;               /**< columns with a positive value in the last LP solution */
+   int                   ncols;
+   int                   colssize;
+};
+typedef struct NodeState NODESTATE;
+
 struct SCIP_PricerData
 {
 	SCIP_CONSHDLR*				sameDiffhdlr;
@@ -22,28 +86,217 @@ struct SCIP_PricerData
 
 	TEST*						testArr;
 	VEHICLE*					vehicleArr;
-	int**						rehitRules;
+	BITMATRIX*					rehitRules;
+
+	/* vehicles with the same release have the same subproblem up to their dual, so the subproblem is solved
+	 * once per class of equal release; the branching decisions of a node split these classes further */
+	int*						releaseClass;	/* class of equal release of each vehicle */
+	int							numReleaseClasses;
+	int*						vehicleClass;	/* pricing class of each vehicle at the current node */
+	int*						classVehicle;	/* first vehicle of each class, it provides the release and decisions */
+	int							numClasses;
+
+	/* the branching decisions of the current node as modifications of the subproblem */
+	int							nwords;			/* words per test bitset */
+	uint64_t*					forbidden;		/* per vehicle the tests it must not serve */
+	SCIP_Bool*					hasForbidden;	/* does the vehicle have a forbidden test? */
+	BITMATRIX*					nodeRehits;		/* rehit rules without the arcs between differ pairs */
+	SCIP_Bool					splitPairs;		/* does the node have a differ decision, i.e. is nodeRehits used? */
+	BITMATRIX**					vehicleRehits;	/* per vehicle the node rules without the arcs its order decisions cut */
+	SCIP_Bool*					ownRehits;		/* does the vehicle have an order decision, i.e. its own rules? */
+	BITMATRIX*					partners;		/* tests merged by same and enforced order decisions */
+	SCIP_Bool					mergedPairs;	/* does the node merge any tests, i.e. is partners used? */
+
+	double*						testDuals;		/* dual value of each test row the subproblems are solved with */
+	double*						vehicleDuals;	/* dual value of each vehicle row the subproblems are solved with */
+	double*						classDuals;		/* largest vehicle dual of each class in the current round */
+	double						costWeight;		/* weight of the column cost in the reduced cost, 0 in Farkas pricing */
+
+	/* Wentges smoothing: the subproblems are solved with a convex combination of the LP duals and the stability
+	 * center, the duals with the best Lagrangian bound at the node so far; a column is only added if its reduced
+	 * cost under the LP duals is negative */
+	double*						lpTestDuals;	/* duals of the test rows in the LP of the current round */
+	double*						lpVehicleDuals;	/* duals of the vehicle rows in the LP of the current round */
+	double*						centerTestDuals;
+	double*						centerVehicleDuals;
+	SCIP_Real					centerBound;	/* Lagrangian bound at the stability center */
+	SCIP_Longint				centerNode;		/* node the center belongs to, -1 for none */
+	SCIP_Bool					smoothed;		/* do the duals of the subproblems differ from the LP duals? */
+	SCIP_Real					smoothing;		/* weight of the center */
+	SCIP_Longint				nrounds;		/* pricing rounds with LP duals */
+	SCIP_Longint				nsmoothed;		/* subproblem runs with smoothed duals */
+	SCIP_Longint				nmispriced;		/* smoothed runs that found no column for the LP */
+	SCIP_Longint				ncenters;		/* updates of the stability center */
+
+	SCIP_Bool					stopearly;		/* stop once the rounded Lagrangian bound reaches the LP value? */
+
+	/* warm start: the children of a node start from its last duals and from its LP columns, repaired to respect
+	 * their branching decisions; the states of the last NODESTATES priced nodes are kept in a ring */
+	NODESTATE*					nodeStates;
+	int							nextState;		/* slot the next new node state goes to */
+	SCIP_Longint				warmNode;		/* last node that was warm started, -1 for none */
+	SCIP_Longint				nwarmnodes;		/* nodes warm started from their parent's state */
+	SCIP_Longint				nwarmcols;		/* repaired parent columns added */
+	SCIP_Longint				nbounds;		/* rounds with a Lagrangian bound */
+	SCIP_Longint				nstopped;		/* nodes where pricing stopped on the bound */
+	LABELRESULT**				classResults;	/* column buffer per class, so that classes can be priced in parallel */
+	int*						classStatus;	/* return code of the last run per class */
+	int							resultCols;		/* maxcols the buffers were created with */
+	THREADPOOL*					pool;			/* NULL when pricing runs in the main thread */
+	int							nthreads;
+
+	int							maxcols;
+	SCIP_Longint				maxlabels;
+	char*						stages;			/* stage characters in the order they are tried */
+	int							maxpertest;
+	int							neighbors;
+	int							maxage;
+
+	SCIP_Longint				ndeleted;		/* columns deleted from the problem */
+	SCIP_Longint				nrestored;		/* columns the pool added again */
+
+	SCIP_CLOCK*					stageClocks[NSTAGES];
+	SCIP_Longint				stageCalls[NSTAGES];
+	SCIP_Longint				stageCols[NSTAGES];
 };
 
+/** frees the per class buffers of the labeling runs */
+static
+void freePricingBuffers(
+	SCIP*					scip,
+	SCIP_PRICERDATA*		pricerdata
+	)
+{
+	if (pricerdata->classResults != NULL)
+	{
+		for (int k = 0; k < pricerdata->numVehicles; ++k)
+			labeling_result_free(&pricerdata->classResults[k]);
+	}
+	if (pricerdata->vehicleRehits != NULL)
+	{
+		for (int v = 0; v < pricerdata->numVehicles; ++v)
+		{
+			if (pricerdata->vehicleRehits[v] != NULL)
+				bitmatrix_release(&pricerdata->vehicleRehits[v]);
+		}
+	}
+	if (pricerdata->nodeRehits != NULL)
+		bitmatrix_release(&pricerdata->nodeRehits);
+	if (pricerdata->partners != NULL)
+		bitmatrix_release(&pricerdata->partners);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleRehits);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->ownRehits);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->hasForbidden);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->forbidden);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->classResults);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->classStatus);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->classDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->testDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->centerVehicleDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->centerTestDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->lpVehicleDuals);
+	SCIPfreeMemoryArrayNull(scip, &pricerdata->lpTestDuals);
+	pricerdata->centerNode = -1;
+	if (pricerdata->nodeStates != NULL)
+	{
+		for (int i = 0; i < NODESTATES; ++i)
+		{
+			SCIPfreeMemoryArrayNull(scip, &pricerdata->nodeStates[i].testDuals);
+			SCIPfreeMemoryArrayNull(scip, &pricerdata->nodeStates[i].vehicleDuals);
+			SCIPfreeMemoryArrayNull(scip, &pricerdata->nodeStates[i].cols);
+		}
+		SCIPfreeMemoryArray(scip, &pricerdata->nodeStates);
+	}
+	pricerdata->warmNode = -1;
+	threadpool_free(&pricerdata->pool);
+	pricerdata->resultCols = 0;
+}
+
+/** sets up the buffers of the labeling runs and the thread pool; since the decisions of a node may put every vehicle
+ *  into a class of its own, the class buffers are sized by the number of vehicles */
 static
 SCIP_RETCODE initPricing(
 	SCIP*					scip,
 	SCIP_PRICERDATA*		pricerdata
-	) 
+	)
 {
+	int nthreads;
+
 	assert(pricerdata != NULL);
 
-	int numTests = pricerdata->numTests;
-	int numVehicles = pricerdata->numVehicles;
-	SCIP_CONS** testConss = pricerdata->testConss;
-	SCIP_CONS* vehicleConss = pricerdata->vehicleConss;
+	if (pricerdata->classResults == NULL)
+	{
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->testDuals, pricerdata->numTests) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->vehicleDuals, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->classDuals, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->lpTestDuals, pricerdata->numTests) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->lpVehicleDuals, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->centerTestDuals, pricerdata->numTests) );
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->centerVehicleDuals, pricerdata->numVehicles) );
+
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->nodeStates, NODESTATES) );
+		for (int i = 0; i < NODESTATES; ++i)
+		{
+			pricerdata->nodeStates[i].node = -1;
+			SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->nodeStates[i].testDuals, pricerdata->numTests) );
+			SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->nodeStates[i].vehicleDuals, pricerdata->numVehicles) );
+		}
+		pricerdata->nextState = 0;
+		SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->classStatus, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->classResults, pricerdata->numVehicles) );
 
-	TEST* testArr = pricerdata->testArr;
-	VEHICLE* vehicleArr = pricerdata->vehicleArr;
+		pricerdata->nwords = bitset_nwords(pricerdata->numTests);
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->forbidden,
+				(size_t) pricerdata->numVehicles * pricerdata->nwords) );
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->hasForbidden, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->ownRehits, pricerdata->numVehicles) );
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &pricerdata->vehicleRehits, pricerdata->numVehicles) );
+	}
 
-	int** rehitRules = pricerdata->rehitRules;
+	/* the column buffers are created by createClassResults when a class first needs one */
+	if (pricerdata->resultCols != pricerdata->maxcols)
+	{
+		for (int k = 0; k < pricerdata->numVehicles; ++k)
+			labeling_result_free(&pricerdata->classResults[k]);
+		pricerdata->resultCols = pricerdata->maxcols;
+	}
 
+	/* more threads than classes of equal release would idle at most nodes */
+	nthreads = pricerdata->nthreads == 0 ? threadpool_ncores() : pricerdata->nthreads;
+	nthreads = MIN(nthreads, pricerdata->numReleaseClasses);
 
+	if (threadpool_nthreads(pricerdata->pool) != nthreads)
+	{
+		threadpool_free(&pricerdata->pool);
+		if (nthreads > 1)
+		{
+			pricerdata->pool = threadpool_create(nthreads);
+			if (pricerdata->pool == NULL)
+				SCIPwarningMessage(scip, "cannot start %d pricing threads, pricing sequentially\n", nthreads);
+		}
+	}
+
+	return SCIP_OKAY;
+}
+
+/** creates the missing column buffers of the current pricing classes */
+static
+SCIP_RETCODE createClassResults(
+	SCIP_PRICERDATA*		pricerdata
+	)
+{
+	for (int k = 0; k < pricerdata->numClasses; ++k)
+	{
+		if (pricerdata->classResults[k] == NULL)
+		{
+			pricerdata->classResults[k] = labeling_result_create(pricerdata->maxcols, pricerdata->numTests);
+			if (pricerdata->classResults[k] == NULL)
+				return SCIP_NOMEMORY;
+		}
+	}
+
+	return SCIP_OKAY;
 }
 
 /** destructor of variable pricer to free user data (called when SCIP is exiting) */
@@ -64,12 +317,18 @@ SCIP_DECL_PRICERFREE(pricerFreeTP3S)
       SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleConss);
       SCIPfreeMemoryArrayNull(scip, &pricerdata->testArr);
       SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleArr);
+      freePricingBuffers(scip, pricerdata);
+      SCIPfreeMemoryArrayNull(scip, &pricerdata->releaseClass);
+      SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleClass);
+      SCIPfreeMemoryArrayNull(scip, &pricerdata->classVehicle);
+
+      if (pricerdata->rehitRules != NULL)
+      	bitmatrix_release(&pricerdata->rehitRules);
 
-      for (int i = 0; i < &pricerdata->numTests; ++i)
+      for( int s = 0; s < NSTAGES; ++s )
       {
-      	SCIPfreeMemoryArrayNull(scip, &pricerdata->rehitRules[i]);
+         SCIP_CALL( SCIPfreeClock(scip, &pricerdata->stageClocks[s]) );
       }
-      SCIPfreeMemoryArrayNull(scip, &pricerdata->rehitRules);
 
       SCIPfreeMemory(scip, &pricerdata);
    }
@@ -121,6 +380,27 @@ SCIP_DECL_PRICERINIT(pricerInitTP3S)
       SCIP_CALL( SCIPcaptureCons(scip, pricerdata->vehicleConss[c]) );
    }
 
+   SCIP_CALL( initPricing(scip, pricerdata) );
+
+   for( c = 0; c < NSTAGES; ++c )
+   {
+      SCIP_CALL( SCIPresetClock(scip, pricerdata->stageClocks[c]) );
+      pricerdata->stageCalls[c] = 0;
+      pricerdata->stageCols[c] = 0;
+   }
+   pricerdata->ndeleted = 0;
+   pricerdata->nrestored = 0;
+   pricerdata->nrounds = 0;
+   pricerdata->nsmoothed = 0;
+   pricerdata->nmispriced = 0;
+   pricerdata->ncenters = 0;
+   pricerdata->centerNode = -1;
+   pricerdata->nbounds = 0;
+   pricerdata->nstopped = 0;
+   pricerdata->warmNode = -1;
+   pricerdata->nwarmnodes = 0;
+   pricerdata->nwarmcols = 0;
+
    return SCIP_OKAY;
 }
 
@@ -137,6 +417,47 @@ SCIP_DECL_PRICEREXITSOL(pricerExitsolTP3S)
    pricerdata = SCIPpricerGetData(pricer);
    assert(pricerdata != NULL);
 
+   for( c = 0; c < NSTAGES; ++c )
+   {
+      if( pricerdata->stageCalls[c] == 0 )
+         continue;
+
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "tp3s pricing %-10s: %8" SCIP_LONGINT_FORMAT " calls, %10" SCIP_LONGINT_FORMAT " columns, %10.2f s\n",
+         stageNames[c], pricerdata->stageCalls[c], pricerdata->stageCols[c],
+         SCIPgetClockTime(scip, pricerdata->stageClocks[c]));
+   }
+
+   if( pricerdata->ndeleted > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "tp3s column pool      : %10" SCIP_LONGINT_FORMAT " deleted, %10" SCIP_LONGINT_FORMAT " restored\n",
+         pricerdata->ndeleted, pricerdata->nrestored);
+   }
+
+   if( pricerdata->nbounds > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "tp3s Lagrangian bound : %10" SCIP_LONGINT_FORMAT " rounds with a bound, %10" SCIP_LONGINT_FORMAT
+         " nodes stopped early\n", pricerdata->nbounds, pricerdata->nstopped);
+   }
+
+   if( pricerdata->nwarmnodes > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "tp3s warm start       : %10" SCIP_LONGINT_FORMAT " nodes, %10" SCIP_LONGINT_FORMAT " repaired columns\n",
+         pricerdata->nwarmnodes, pricerdata->nwarmcols);
+   }
+
+   /* the rounds saved are the difference to the rounds of a run with pricers/tp3s/smoothing = 0 */
+   if( pricerdata->nsmoothed > 0 )
+   {
+      SCIPverbMessage(scip, SCIP_VERBLEVEL_NORMAL, NULL,
+         "tp3s smoothing        : %10" SCIP_LONGINT_FORMAT " rounds, %10" SCIP_LONGINT_FORMAT " smoothed, %10"
+         SCIP_LONGINT_FORMAT " mispriced, %10" SCIP_LONGINT_FORMAT " center updates\n",
+         pricerdata->nrounds, pricerdata->nsmoothed, pricerdata->nmispriced, pricerdata->ncenters);
+   }
+
    /* get release constraints */
    for( c = 0; c < pricerdata->numTests; ++c )
    {
@@ -154,25 +475,1378 @@ SCIP_DECL_PRICEREXITSOL(pricerExitsolTP3S)
    return SCIP_OKAY;
 }
 
+/** returns the dual or Farkas dual of a vehicle row, a set packing row per vehicle or a linear capacity row per
+ *  class */
+static
+SCIP_Real getVehicleDual(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons,               /**< vehicle row */
+   SCIP_Bool             farkas              /**< should the Farkas dual be returned? */
+   )
+{
+   if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "linear") == 0 )
+      return farkas ? SCIPgetDualfarkasLinear(scip, cons) : SCIPgetDualsolLinear(scip, cons);
+
+   return farkas ? SCIPgetDualfarkasSetppc(scip, cons) : SCIPgetDualsolSetppc(scip, cons);
+}
+
+/** groups the vehicles by release; the classes are numbered in order of their first vehicle and serve as pricing
+ *  classes as long as no branching decision tells the vehicles apart */
+static
+SCIP_RETCODE computeClasses(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   int numClasses;
+
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->releaseClass, pricerdata->numVehicles) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->vehicleClass, pricerdata->numVehicles) );
+   SCIP_CALL( SCIPallocMemoryArray(scip, &pricerdata->classVehicle, pricerdata->numVehicles) );
+
+   numClasses = 0;
+   for( int v = 0; v < pricerdata->numVehicles; ++v )
+   {
+      int k;
+
+      for( k = 0; k < numClasses; ++k )
+      {
+         if( pricerdata->vehicleArr[pricerdata->classVehicle[k]].release == pricerdata->vehicleArr[v].release )
+            break;
+      }
+
+      if( k == numClasses )
+         pricerdata->classVehicle[numClasses++] = v;
+
+      pricerdata->releaseClass[v] = k;
+      pricerdata->vehicleClass[v] = k;
+   }
+   pricerdata->numReleaseClasses = numClasses;
+   pricerdata->numClasses = numClasses;
+
+   return SCIP_OKAY;
+}
+
+/** returns the rehit rules vehicle v is priced with at the current node */
+static
+const BITMATRIX* vehicleRules(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   v                   /**< vehicle */
+   )
+{
+   if( pricerdata->ownRehits[v] )
+      return pricerdata->vehicleRehits[v];
+
+   return pricerdata->splitPairs ? pricerdata->nodeRehits : pricerdata->rehitRules;
+}
+
+/** copies the rehit rules into *copy, creating it on first use */
+static
+SCIP_RETCODE copyRules(
+   const BITMATRIX*      source,             /**< rules to copy */
+   BITMATRIX**           copy                /**< pointer to the copy */
+   )
+{
+   if( *copy == NULL )
+   {
+      *copy = bitmatrix_create(source->nrows, source->ncols);
+      if( *copy == NULL )
+         return SCIP_NOMEMORY;
+   }
+
+   memcpy((*copy)->words, source->words, (size_t) source->nrows * source->nwords * sizeof(uint64_t));
+
+   return SCIP_OKAY;
+}
+
+/** returns the representative of a test's group of merged tests */
+static
+int findGroup(
+   int*                  group,              /**< parent of each test, a representative is its own parent */
+   int                   t                   /**< test */
+   )
+{
+   while( group[t] != t )
+   {
+      group[t] = group[group[t]];
+      t = group[t];
+   }
+
+   return t;
+}
+
+/** forbids a test on every vehicle but one */
+static
+void forbidElsewhere(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   int                   tid,                /**< test */
+   int                   vid                 /**< vehicle that may serve it */
+   )
+{
+   for( int v = 0; v < pricerdata->numVehicles; ++v )
+   {
+      if( v == vid )
+         continue;
+
+      bitset_set(pricerdata->forbidden + (size_t) v * pricerdata->nwords, tid);
+      pricerdata->hasForbidden[v] = TRUE;
+   }
+}
+
+/** translates the active branching decisions of the node into the subproblems of the vehicles:
+ *  - same merges the two tests, differ removes the arcs between them from the rules of every vehicle,
+ *  - a test enforced on a vehicle is forbidden on all others, a forbidden one only on that vehicle,
+ *  - an enforced order merges the tests, forbids them on the other vehicles and removes the arc from the second to
+ *    the first test from the rules of its vehicle; a forbidden order only removes the arc from the first to the second
+ */
+static
+SCIP_RETCODE readDecisions(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   SCIP_CONS** conss;
+   int* group;
+   int nconss;
+   int c, i, j;
+
+   BMSclearMemoryArray(pricerdata->forbidden, (size_t) pricerdata->numVehicles * pricerdata->nwords);
+   BMSclearMemoryArray(pricerdata->hasForbidden, pricerdata->numVehicles);
+   BMSclearMemoryArray(pricerdata->ownRehits, pricerdata->numVehicles);
+   pricerdata->splitPairs = FALSE;
+   pricerdata->mergedPairs = FALSE;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &group, pricerdata->numTests) );
+   for( i = 0; i < pricerdata->numTests; ++i )
+      group[i] = i;
+
+   if( pricerdata->sameDiffhdlr != NULL )
+   {
+      conss = SCIPconshdlrGetConss(pricerdata->sameDiffhdlr);
+      nconss = SCIPconshdlrGetNActiveConss(pricerdata->sameDiffhdlr);
+
+      for( c = 0; c < nconss; ++c )
+      {
+         int tid1 = SCIPgetTid1Samediff(scip, conss[c]);
+         int tid2 = SCIPgetTid2Samediff(scip, conss[c]);
+
+         if( SCIPgetTypeSamediff(scip, conss[c]) == SAME )
+         {
+            group[findGroup(group, tid1)] = findGroup(group, tid2);
+            pricerdata->mergedPairs = TRUE;
+            continue;
+         }
+
+         if( !pricerdata->splitPairs )
+         {
+            SCIP_CALL( copyRules(pricerdata->rehitRules, &pricerdata->nodeRehits) );
+            pricerdata->splitPairs = TRUE;
+         }
+         bitmatrix_set(pricerdata->nodeRehits, tid1, tid2, 0);
+         bitmatrix_set(pricerdata->nodeRehits, tid2, tid1, 0);
+      }
+   }
+
+   if( pricerdata->testOnVehiclehdlr != NULL )
+   {
+      conss = SCIPconshdlrGetConss(pricerdata->testOnVehiclehdlr);
+      nconss = SCIPconshdlrGetNActiveConss(pricerdata->testOnVehiclehdlr);
+
+      for( c = 0; c < nconss; ++c )
+      {
+         int tid = SCIPgetTidTestOnVehicle(scip, conss[c]);
+         int vid = SCIPgetVidTestOnVehicle(scip, conss[c]);
+
+         if( SCIPgetTypeTestOnVehicle(scip, conss[c]) == ENFORCE )
+            forbidElsewhere(pricerdata, tid, vid);
+         else
+         {
+            bitset_set(pricerdata->forbidden + (size_t) vid * pricerdata->nwords, tid);
+            pricerdata->hasForbidden[vid] = TRUE;
+         }
+      }
+   }
+
+   if( pricerdata->testOrderhdlr != NULL )
+   {
+      conss = SCIPconshdlrGetConss(pricerdata->testOrderhdlr);
+      nconss = SCIPconshdlrGetNActiveConss(pricerdata->testOrderhdlr);
+
+      for( c = 0; c < nconss; ++c )
+      {
+         int tid1 = SCIPgetTid1TestOrderOnVehicle(scip, conss[c]);
+         int tid2 = SCIPgetTid2TestOrderOnVehicle(scip, conss[c]);
+         int vid = SCIPgetVidTestOrderOnVehicle(scip, conss[c]);
+
+         /* the vehicle's rules start from the node rules, which are complete after the differ decisions */
+         if( !pricerdata->ownRehits[vid] )
+         {
+            SCIP_CALL( copyRules(vehicleRules(pricerdata, vid), &pricerdata->vehicleRehits[vid]) );
+            pricerdata->ownRehits[vid] = TRUE;
+         }
+
+         if( SCIPgetTypeTestOrderOnVehicle(scip, conss[c]) == ENFORCE )
+         {
+            group[findGroup(group, tid1)] = findGroup(group, tid2);
+            pricerdata->mergedPairs = TRUE;
+            forbidElsewhere(pricerdata, tid1, vid);
+            forbidElsewhere(pricerdata, tid2, vid);
+            bitmatrix_set(pricerdata->vehicleRehits[vid], tid2, tid1, 0);
+         }
+         else
+            bitmatrix_set(pricerdata->vehicleRehits[vid], tid1, tid2, 0);
+      }
+   }
+
+   /* the labeling needs the partners closed under transitivity, i.e. all tests of a group */
+   if( pricerdata->mergedPairs )
+   {
+      if( pricerdata->partners == NULL )
+      {
+         pricerdata->partners = bitmatrix_create(pricerdata->numTests, pricerdata->numTests);
+         if( pricerdata->partners == NULL )
+         {
+            SCIPfreeBufferArray(scip, &group);
+            return SCIP_NOMEMORY;
+         }
+      }
+      BMSclearMemoryArray(pricerdata->partners->words, (size_t) pricerdata->numTests * pricerdata->partners->nwords);
+
+      for( i = 0; i < pricerdata->numTests; ++i )
+         group[i] = findGroup(group, i);
+
+      for( i = 0; i < pricerdata->numTests; ++i )
+      {
+         for( j = i + 1; j < pricerdata->numTests; ++j )
+         {
+            if( group[i] == group[j] )
+            {
+               bitmatrix_set(pricerdata->partners, i, j, 1);
+               bitmatrix_set(pricerdata->partners, j, i, 1);
+            }
+         }
+      }
+   }
+
+   SCIPfreeBufferArray(scip, &group);
+
+   return SCIP_OKAY;
+}
+
+/** splits the classes of equal release into pricing classes of vehicles that also share their decisions; a vehicle
+ *  with rules of its own is priced alone */
+static
+void splitClasses(
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   int numClasses = 0;
+
+   for( int v = 0; v < pricerdata->numVehicles; ++v )
+   {
+      const uint64_t* forbidden = pricerdata->forbidden + (size_t) v * pricerdata->nwords;
+      int k;
+
+      for( k = 0; k < numClasses && !pricerdata->ownRehits[v]; ++k )
+      {
+         int u = pricerdata->classVehicle[k];
+
+         if( pricerdata->releaseClass[u] == pricerdata->releaseClass[v] && !pricerdata->ownRehits[u]
+            && memcmp(pricerdata->forbidden + (size_t) u * pricerdata->nwords, forbidden,
+               pricerdata->nwords * sizeof(uint64_t)) == 0 )
+            break;
+      }
+
+      if( k == numClasses || pricerdata->ownRehits[v] )
+      {
+         k = numClasses;
+         pricerdata->classVehicle[numClasses++] = v;
+      }
+
+      pricerdata->vehicleClass[v] = k;
+   }
+   pricerdata->numClasses = numClasses;
+}
+
+/** prices one vehicle class in a stage; runs in a thread of the pool */
+static
+void priceClassTask(
+   void*                 arg,                /**< the pricing job */
+   int                   k                   /**< class to price */
+   )
+{
+   PRICINGJOB* job = (PRICINGJOB*) arg;
+   SCIP_PRICERDATA* pricerdata = job->pricerdata;
+   LABELPROB prob;
+   int v = pricerdata->classVehicle[k];
+
+   prob.tests = pricerdata->testArr;
+   prob.rehits = vehicleRules(pricerdata, v);
+   prob.forbidden = pricerdata->hasForbidden[v] ? pricerdata->forbidden + (size_t) v * pricerdata->nwords : NULL;
+   prob.partners = pricerdata->mergedPairs ? pricerdata->partners : NULL;
+   prob.testDuals = pricerdata->testDuals;
+   prob.numTests = pricerdata->numTests;
+   prob.release = pricerdata->vehicleArr[v].release;
+   prob.vehicleDual = pricerdata->classDuals[k];
+   prob.costWeight = pricerdata->costWeight;
+
+   if( job->stage == STAGE_GREEDY )
+      pricerdata->classStatus[k] = labeling_greedy(&prob, job->threshold, pricerdata->classResults[k]);
+   else
+      pricerdata->classStatus[k] = labeling_solve(&prob, &job->limits, job->threshold, pricerdata->classResults[k]);
+}
+
+/** returns the reduced cost of a column under the duals of the LP */
+static
+SCIP_Real lpRedcost(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   const int*            tests,              /**< tests of the column */
+   int                   ntests,             /**< number of tests */
+   int                   v,                  /**< vehicle row of the column */
+   SCIP_Real             cost                /**< cost of the column */
+   )
+{
+   SCIP_Real redcost = pricerdata->costWeight * cost - pricerdata->lpVehicleDuals[v];
+
+   for( int k = 0; k < ntests; ++k )
+      redcost -= pricerdata->lpTestDuals[tests[k]];
+
+   return redcost;
+}
+
+/** adds the columns of the last stage as one block; the classes were priced with the dual of their best vehicle, so
+ *  each vehicle of a class only gets the columns whose own reduced cost stays below the threshold */
+static
+SCIP_RETCODE addStageColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   SCIP_Real             threshold,          /**< reduced cost a column must stay below */
+   int*                  ncols               /**< pointer to store the number of columns added */
+   )
+{
+   SCIP_Real* colCosts;
+   int* colTests;
+   int* colBeg;
+   int* colRows;
+   int maxcols;
+   int maxnnz;
+   int nnz;
+   int v, k, c;
+
+   /* the columns of all vehicles are collected and added as one block */
+   maxcols = 0;
+   maxnnz = 0;
+   for( v = 0; v < pricerdata->numVehicles; ++v )
+   {
+      LABELRESULT* labelResult = pricerdata->classResults[pricerdata->vehicleClass[v]];
+
+      maxcols += labelResult->ncols;
+      for( c = 0; c < labelResult->ncols; ++c )
+         maxnnz += labelResult->cols[c].ntests;
+   }
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &colTests, maxnnz + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colBeg, maxcols + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colRows, maxcols + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colCosts, maxcols + 1) );
+
+   nnz = 0;
+   for( v = 0; v < pricerdata->numVehicles; ++v )
+   {
+      LABELRESULT* labelResult;
+
+      k = pricerdata->vehicleClass[v];
+      labelResult = pricerdata->classResults[k];
+
+      for( c = 0; c < labelResult->ncols; ++c )
+      {
+         LABELCOLUMN* col = &labelResult->cols[c];
+
+         /* the class was priced with the dual of its best vehicle; with smoothed duals the column must also
+          * improve the LP */
+         if( col->redcost + pricerdata->classDuals[k] - pricerdata->vehicleDuals[v] >= threshold )
+            continue;
+         if( pricerdata->smoothed
+            && lpRedcost(pricerdata, col->tests, col->ntests, v, (SCIP_Real) col->cost) >= threshold )
+            continue;
+
+         colBeg[*ncols] = nnz;
+         colRows[*ncols] = v;
+         colCosts[*ncols] = (SCIP_Real) col->cost;
+         BMScopyMemoryArray(colTests + nnz, col->tests, col->ntests);
+         nnz += col->ntests;
+         (*ncols)++;
+      }
+   }
+   colBeg[*ncols] = nnz;
+
+   SCIP_CALL( SCIPprobdataAddColumns(scip, probdata, colTests, colBeg, colRows, colCosts, *ncols, TRUE) );
+
+   SCIPfreeBufferArray(scip, &colCosts);
+   SCIPfreeBufferArray(scip, &colRows);
+   SCIPfreeBufferArray(scip, &colBeg);
+   SCIPfreeBufferArray(scip, &colTests);
+
+   return SCIP_OKAY;
+}
+
+/** runs one stage of the pricing cascade for every vehicle class and adds the columns found; the classes are
+ *  priced on the thread pool with the largest dual of their vehicles, so that their columns include the best ones
+ *  of every vehicle of the class. The columns are then handed to each vehicle of the class whose own reduced cost
+ *  stays negative, in vehicle order so that runs are reproducible */
+static
+SCIP_RETCODE priceStage(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   PRICINGSTAGE          stage,              /**< stage to run */
+   int*                  ncols,              /**< pointer to store the number of columns added */
+   SCIP_Bool*            complete            /**< pointer to store whether the search was exhaustive */
+   )
+{
+   PRICINGJOB job;
+   SCIP_RETCODE retcode;
+   SCIP_Longint ncreated;
+   SCIP_Longint ndominated;
+   SCIP_Longint nextended;
+   int k;
+
+   job.pricerdata = pricerdata;
+   job.stage = stage;
+   job.limits.maxlabels = (long) pricerdata->maxlabels;
+   job.limits.maxpertest = stage == STAGE_TRUNCATED ? pricerdata->maxpertest : 0;
+   job.limits.neighbors = stage == STAGE_RESTRICTED ? pricerdata->neighbors : 0;
+   job.threshold = -SCIPdualfeastol(scip);
+
+   *complete = TRUE;
+   *ncols = 0;
+   ncreated = 0;
+   ndominated = 0;
+   nextended = 0;
+
+   SCIP_CALL( SCIPstartClock(scip, pricerdata->stageClocks[stage]) );
+
+   threadpool_run(pricerdata->pool, priceClassTask, &job, pricerdata->numClasses);
+
+   retcode = SCIP_OKAY;
+   for( k = 0; k < pricerdata->numClasses; ++k )
+   {
+      LABELRESULT* labelResult = pricerdata->classResults[k];
+
+      if( pricerdata->classStatus[k] != 0 )
+      {
+         retcode = SCIP_NOMEMORY;
+         continue;
+      }
+
+      if( !labelResult->complete )
+         *complete = FALSE;
+
+      ncreated += labelResult->nlabels;
+      ndominated += labelResult->ndominated;
+      nextended += labelResult->nextended;
+   }
+
+   /* the clock also stops when the stage fails */
+   if( retcode == SCIP_OKAY )
+      retcode = addStageColumns(scip, pricerdata, probdata, job.threshold, ncols);
+
+   SCIP_CALL( SCIPstopClock(scip, pricerdata->stageClocks[stage]) );
+   SCIP_CALL( retcode );
+
+   pricerdata->stageCalls[stage]++;
+   pricerdata->stageCols[stage] += *ncols;
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_HIGH, NULL,
+      "tp3s pricing %s: %d columns, labels created %" SCIP_LONGINT_FORMAT ", dominated %" SCIP_LONGINT_FORMAT
+      ", extended %" SCIP_LONGINT_FORMAT ", %.3f s total%s\n", stageNames[stage], *ncols, ncreated, ndominated,
+      nextended, SCIPgetClockTime(scip, pricerdata->stageClocks[stage]), *complete ? "" : " (limit reached)");
+
+   return SCIP_OKAY;
+}
+
+/** does a pool column respect the branching decisions of the node? it must not serve a test its vehicle is forbidden,
+ *  must serve the partners of its tests and must follow the rules of its vehicle for every pair of its tests */
+static
+SCIP_Bool poolColumnAllowed(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_VARDATA*         vardata             /**< data of the pool column */
+   )
+{
+   const uint64_t* signature = SCIPvardataGetSignature(vardata);
+   const BITMATRIX* rules;
+   int* sequence;
+   int ntests;
+   int v;
+
+   v = SCIPvardataGetVehicleConsids(vardata);
+   ntests = SCIPvardataGetNConsids(vardata);
+   sequence = SCIPvardataGetSequence(vardata);
+
+   if( pricerdata->hasForbidden[v] && bitset_and_popcount(signature,
+         pricerdata->forbidden + (size_t) v * pricerdata->nwords, pricerdata->nwords) > 0 )
+      return FALSE;
+
+   if( pricerdata->mergedPairs )
+   {
+      for( int p = 0; p < ntests; ++p )
+      {
+         const uint64_t* row = bitmatrix_row(pricerdata->partners, sequence[p]);
+
+         for( int w = 0; w < pricerdata->nwords; ++w )
+         {
+            if( (row[w] & ~signature[w]) != 0 )
+               return FALSE;
+         }
+      }
+   }
+
+   /* the node rules only lose arcs, so only the columns of vehicles with changed rules need the check */
+   if( !pricerdata->splitPairs && !pricerdata->ownRehits[v] )
+      return TRUE;
+
+   rules = vehicleRules(pricerdata, v);
+   for( int p = 0; p < ntests; ++p )
+   {
+      for( int q = p + 1; q < ntests; ++q )
+      {
+         if( !bitmatrix_get(rules, sequence[p], sequence[q]) )
+            return FALSE;
+      }
+   }
+
+   return TRUE;
+}
+
+/** prices the deleted columns in the pool against the LP duals of the round and adds those with negative reduced cost
+ *  again; this is much cheaper than a labeling run, which would mostly find them again */
+static
+SCIP_RETCODE pricePool(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int*                  ncols               /**< pointer to store the number of columns added */
+   )
+{
+   SCIP_VARDATA** pool;
+   int* idx;
+   int npool;
+
+   *ncols = 0;
+
+   pool = SCIPprobdataGetPoolColumns(probdata);
+   npool = SCIPprobdataGetNPoolColumns(probdata);
+
+   if( npool == 0 )
+      return SCIP_OKAY;
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &idx, npool) );
+
+   for( int i = 0; i < npool; ++i )
+   {
+      SCIP_Real redcost;
+
+      redcost = lpRedcost(pricerdata, SCIPvardataGetConsids(pool[i]), SCIPvardataGetNConsids(pool[i]),
+         SCIPvardataGetVehicleConsids(pool[i]), SCIPvardataGetCost(pool[i]));
+
+      if( SCIPisDualfeasNegative(scip, redcost) && poolColumnAllowed(pricerdata, pool[i]) )
+         idx[(*ncols)++] = i;
+   }
+
+   SCIP_CALL( SCIPprobdataRestoreColumns(scip, probdata, idx, *ncols) );
+   pricerdata->nrestored += *ncols;
+
+   SCIPfreeBufferArray(scip, &idx);
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_HIGH, NULL, "tp3s pricing pool: %d of %d columns restored\n", *ncols, npool);
+
+   return SCIP_OKAY;
+}
+
+/** returns the state the given node left, NULL if it is not kept */
+static
+NODESTATE* findNodeState(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_Longint          node                /**< node number */
+   )
+{
+   for( int i = 0; i < NODESTATES; ++i )
+   {
+      if( pricerdata->nodeStates[i].node == node )
+         return &pricerdata->nodeStates[i];
+   }
+
+   return NULL;
+}
+
+/** returns the state the parent of the current node left, NULL at the root or if it is not kept any more */
+static
+NODESTATE* findParentState(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   SCIP_NODE* parent = SCIPnodeGetParent(SCIPgetCurrentNode(scip));
+
+   return parent != NULL ? findNodeState(pricerdata, SCIPnodeGetNumber(parent)) : NULL;
+}
+
+/** stores the LP duals of the round and the columns of the LP solution as the state of the current node */
+static
+SCIP_RETCODE saveNodeState(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata          /**< pricer data */
+   )
+{
+   SCIP_Longint node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+   NODESTATE* state;
+   SCIP_COL** cols;
+   int ncols;
+
+   state = findNodeState(pricerdata, node);
+   if( state == NULL )
+   {
+      state = &pricerdata->nodeStates[pricerdata->nextState];
+      pricerdata->nextState = (pricerdata->nextState + 1) % NODESTATES;
+      state->node = node;
+   }
+
+   BMScopyMemoryArray(state->testDuals, pricerdata->lpTestDuals, pricerdata->numTests);
+   BMScopyMemoryArray(state->vehicleDuals, pricerdata->lpVehicleDuals, pricerdata->numVehicles);
+
+   /* the records of the columns stay in the column arena even if the columns are deleted later */
+   SCIP_CALL( SCIPgetLPColsData(scip, &cols, &ncols) );
+
+   state->ncols = 0;
+   for( int c = 0; c < ncols; ++c )
+   {
+      SCIP_VARDATA* vardata = SCIPvarGetData(SCIPcolGetVar(cols[c]));
+
+      if( vardata == NULL || !SCIPisFeasPositive(scip, SCIPcolGetPrimsol(cols[c])) )
+         continue;
+
+      if( state->ncols == state->colssize )
+      {
+         state->colssize = MAX(16, 2 * state->colssize);
+         SCIP_CALL( SCIPreallocMemoryArray(scip, &state->cols, state->colssize) );
+      }
+      state->cols[state->ncols++] = vardata;
+   }
+
+   return SCIP_OKAY;
+}
+
+/** copies the sequence of a column into seq and drops the tests that break the decisions of the node: tests its
+ *  vehicle must not serve, tests that would follow an earlier test against the rules of its vehicle, and tests whose
+ *  partners are not all served; returns the length of the repaired sequence */
+static
+int repairColumn(
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_VARDATA*         vardata,            /**< column to repair */
+   int*                  seq,                /**< buffer for the repaired sequence */
+   uint64_t*             kept,               /**< buffer for the tests of the repaired sequence */
+   SCIP_Bool*            repaired            /**< pointer to store whether a test was dropped */
+   )
+{
+   int v = SCIPvardataGetVehicleConsids(vardata);
+   const BITMATRIX* rules = vehicleRules(pricerdata, v);
+   const uint64_t* forbidden = pricerdata->hasForbidden[v] ? pricerdata->forbidden + (size_t) v * pricerdata->nwords
+      : NULL;
+   SCIP_Bool changed;
+   int len;
+
+   len = SCIPvardataGetNConsids(vardata);
+   BMScopyMemoryArray(seq, SCIPvardataGetSequence(vardata), len);
+   *repaired = FALSE;
+
+   /* dropping a test may leave its partners incomplete, so the passes repeat until nothing changes */
+   do
+   {
+      int n = 0;
+
+      changed = FALSE;
+      BMSclearMemoryArray(kept, pricerdata->nwords);
+
+      for( int p = 0; p < len; ++p )
+      {
+         int j = seq[p];
+         SCIP_Bool ok = forbidden == NULL || !bitset_get(forbidden, j);
+
+         for( int q = 0; q < n && ok; ++q )
+            ok = bitmatrix_get(rules, seq[q], j);
+
+         if( ok )
+         {
+            seq[n++] = j;
+            bitset_set(kept, j);
+         }
+         else
+            *repaired = TRUE;
+      }
+      len = n;
+
+      if( pricerdata->mergedPairs )
+      {
+         n = 0;
+         for( int p = 0; p < len; ++p )
+         {
+            const uint64_t* row = bitmatrix_row(pricerdata->partners, seq[p]);
+            int w;
+
+            for( w = 0; w < pricerdata->nwords && (row[w] & ~kept[w]) == 0; ++w )
+               ;
+
+            if( w == pricerdata->nwords )
+               seq[n++] = seq[p];
+            else
+               changed = TRUE;
+         }
+         len = n;
+      }
+
+      if( changed )
+         *repaired = TRUE;
+   }
+   while( changed );
+
+   return len;
+}
+
+/** warm starts the first round at a node from the state of its parent: the columns of the parent's last LP solution
+ *  that break the decisions of the node are fixed to zero there, so they are repaired and priced at the LP duals of
+ *  the node */
+static
+SCIP_RETCODE warmStart(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   NODESTATE*            state,              /**< state of the parent */
+   int*                  ncols               /**< pointer to store the number of columns added */
+   )
+{
+   SCIP_Real* colCosts;
+   uint64_t* kept;
+   int* colTests;
+   int* colBeg;
+   int* colRows;
+   int maxnnz;
+   int nnz;
+
+   *ncols = 0;
+
+   if( state->ncols == 0 )
+      return SCIP_OKAY;
+
+   maxnnz = 0;
+   for( int c = 0; c < state->ncols; ++c )
+      maxnnz += SCIPvardataGetNConsids(state->cols[c]);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &colTests, maxnnz) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colBeg, state->ncols + 1) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colRows, state->ncols) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &colCosts, state->ncols) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &kept, pricerdata->nwords) );
+
+   nnz = 0;
+   for( int c = 0; c < state->ncols; ++c )
+   {
+      SCIP_VARDATA* vardata = state->cols[c];
+      SCIP_Bool repaired;
+      int v = SCIPvardataGetVehicleConsids(vardata);
+      int cost;
+      int len;
+
+      /* a column that respects the decisions is still in the problem or in the pool */
+      len = repairColumn(pricerdata, vardata, colTests + nnz, kept, &repaired);
+      if( !repaired || len == 0 )
+         continue;
+
+      cost = sequence_cost(pricerdata->testArr, colTests + nnz, len, pricerdata->vehicleArr[v].release);
+      if( !SCIPisDualfeasNegative(scip, lpRedcost(pricerdata, colTests + nnz, len, v, (SCIP_Real) cost)) )
+         continue;
+
+      colBeg[*ncols] = nnz;
+      colRows[*ncols] = v;
+      colCosts[*ncols] = (SCIP_Real) cost;
+      nnz += len;
+      (*ncols)++;
+   }
+   colBeg[*ncols] = nnz;
+
+   SCIP_CALL( SCIPprobdataAddColumns(scip, probdata, colTests, colBeg, colRows, colCosts, *ncols, TRUE) );
+   pricerdata->nwarmcols += *ncols;
+
+   SCIPfreeBufferArray(scip, &kept);
+   SCIPfreeBufferArray(scip, &colCosts);
+   SCIPfreeBufferArray(scip, &colRows);
+   SCIPfreeBufferArray(scip, &colBeg);
+   SCIPfreeBufferArray(scip, &colTests);
+
+   SCIPverbMessage(scip, SCIP_VERBLEVEL_HIGH, NULL, "tp3s pricing warm start: %d of %d parent columns repaired\n",
+      *ncols, state->ncols);
+
+   return SCIP_OKAY;
+}
+
+/** returns the right hand side of a vehicle row: 1 for a set packing row, the class size for a capacity row */
+static
+SCIP_Real getVehicleCapacity(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS*            cons                /**< vehicle row */
+   )
+{
+   if( strcmp(SCIPconshdlrGetName(SCIPconsGetHdlr(cons)), "linear") == 0 )
+      return SCIPgetRhsLinear(scip, cons);
+
+   return 1.0;
+}
+
+/** sets the duals the subproblems are solved with to alpha times the stability center plus 1 - alpha times the LP
+ *  duals */
+static
+void setPricingDuals(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_Real             alpha               /**< weight of the center, 0 for the LP duals */
+   )
+{
+   int i;
+
+   for( i = 0; i < pricerdata->numTests; ++i )
+   {
+      pricerdata->testDuals[i] = alpha * pricerdata->centerTestDuals[i]
+         + (1.0 - alpha) * pricerdata->lpTestDuals[i];
+   }
+   for( i = 0; i < pricerdata->numClasses; ++i )
+      pricerdata->classDuals[i] = -SCIPinfinity(scip);
+   for( i = 0; i < pricerdata->numVehicles; ++i )
+   {
+      int k = pricerdata->vehicleClass[i];
+
+      pricerdata->vehicleDuals[i] = alpha * pricerdata->centerVehicleDuals[i]
+         + (1.0 - alpha) * pricerdata->lpVehicleDuals[i];
+      pricerdata->classDuals[k] = MAX(pricerdata->classDuals[k], pricerdata->vehicleDuals[i]);
+   }
+
+   pricerdata->smoothed = alpha > 0.0;
+}
+
+/** returns the Lagrangian bound of the node at the duals the subproblems were solved with, after an exhaustive stage:
+ *  the dual objective plus, for every vehicle row, its capacity times the smallest reduced cost of its columns, and
+ *  for every test the reduced cost of its slack column if that is negative */
+static
+SCIP_Real lagrangeBound(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+   SCIP_Real slackcost = SCIPprobdataGetSlackCost(probdata);
+   SCIP_Real bound = 0.0;
+   int i;
+
+   for( i = 0; i < pricerdata->numTests; ++i )
+   {
+      bound += pricerdata->testDuals[i];
+      if( !SCIPisInfinity(scip, slackcost) )
+         bound += MIN(0.0, slackcost - pricerdata->testDuals[i]);
+   }
+
+   /* the best reduced cost of a class is at most 0 and belongs to the vehicle with the largest dual */
+   for( i = 0; i < pricerdata->numVehicles; ++i )
+   {
+      int k = pricerdata->vehicleClass[i];
+      SCIP_Real redcost;
+
+      redcost = pricerdata->classResults[k]->bestredcost + pricerdata->classDuals[k] - pricerdata->vehicleDuals[i];
+      bound += getVehicleCapacity(scip, pricerdata->vehicleConss[i]) * (pricerdata->vehicleDuals[i] + MIN(0.0, redcost));
+   }
+
+   return bound;
+}
+
+/** runs the stages of the cascade in the configured order; a stage only runs if the stages before found no column */
+static
+SCIP_RETCODE runStages(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int*                  ncols,              /**< pointer to store the number of columns added */
+   SCIP_Bool*            complete            /**< pointer to store whether the last stage was exhaustive */
+   )
+{
+   const char* stage;
+
+   *ncols = 0;
+   *complete = FALSE;
+
+   for( stage = pricerdata->stages; *stage != '\0' && *ncols == 0; ++stage )
+   {
+      int s;
+
+      for( s = 0; s < NSTAGES && stageChars[s] != *stage; ++s )
+         ;
+
+      if( s == NSTAGES )
+      {
+         SCIPwarningMessage(scip, "unknown pricing stage <%c> in pricers/tp3s/stages ignored\n", *stage);
+         continue;
+      }
+
+      SCIP_CALL( priceStage(scip, pricerdata, probdata, (PRICINGSTAGE) s, ncols, complete) );
+   }
+
+   return SCIP_OKAY;
+}
+
+/** prices columns for the current node with the duals of a feasible LP or the Farkas duals of an infeasible one
+ *
+ *  the columns that stayed out of the LP too long are deleted first, and the pool of deleted columns is priced; the
+ *  stages of the cascade only run if the pool has no column with negative reduced cost. With smoothing, the stages
+ *  solve the subproblems at a point between the stability center and the LP duals; if that point misprices, i.e.
+ *  yields no column that improves the LP, the weight of the center shrinks until the LP duals themselves are priced.
+ *  Every exhaustive run yields a Lagrangian bound, which is reported as lower bound of the node and may end pricing
+ *  at the node early. With Farkas duals the column cost drops out of the reduced cost, and a column with negative
+ *  Farkas reduced cost breaks the infeasibility proof of the LP
+ */
+static
+SCIP_RETCODE priceColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PRICERDATA*      pricerdata,         /**< pricer data */
+   SCIP_Bool             farkas,             /**< is the LP infeasible, i.e. are the Farkas duals priced? */
+   SCIP_Real*            lowerbound,         /**< pointer to store a lower bound of the node, NULL in Farkas pricing */
+   SCIP_Bool*            stopearly,          /**< pointer to store whether pricing at the node can stop, or NULL */
+   SCIP_RESULT*          result              /**< pointer to store the result of the pricing call */
+   )
+{
+   SCIP_PROBDATA* probdata;
+   SCIP_Bool complete;
+   SCIP_Bool smoothing;
+   SCIP_Bool probing;
+   SCIP_Real nodebound;
+   SCIP_Real alpha;
+   int ndeleted;
+   int ncols;
+   int i;
+
+   probdata = SCIPgetProbData(scip);
+   assert(probdata != NULL);
+
+   /* a diving heuristic prices in probing mode; its nodes are not part of the tree, so they neither keep a state for
+    * children nor move the stability center, and columns cannot be deleted while probing */
+   probing = SCIPinProbing(scip);
+
+   SCIP_CALL( initPricing(scip, pricerdata) );
+
+   /* the subproblems only admit columns that respect the branching decisions of the node */
+   SCIP_CALL( readDecisions(scip, pricerdata) );
+   splitClasses(pricerdata);
+   SCIP_CALL( createClassResults(pricerdata) );
+
+   /* covering rows have a nonnegative dual, packing rows a nonpositive one; the pricing threads only read the
+    * copies */
+   pricerdata->costWeight = farkas ? 0.0 : 1.0;
+   for( i = 0; i < pricerdata->numTests; ++i )
+   {
+      pricerdata->lpTestDuals[i] = farkas ? SCIPgetDualfarkasSetppc(scip, pricerdata->testConss[i])
+         : SCIPgetDualsolSetppc(scip, pricerdata->testConss[i]);
+   }
+   for( i = 0; i < pricerdata->numVehicles; ++i )
+      pricerdata->lpVehicleDuals[i] = getVehicleDual(scip, pricerdata->vehicleConss[i], farkas);
+
+   if( !farkas && !probing )
+   {
+      SCIP_CALL( saveNodeState(scip, pricerdata) );
+   }
+
+   /* keeps the LP and the propagation scans short on long runs; Farkas duals say nothing about the value of a
+    * column, so columns only age in a feasible LP */
+   if( !farkas && !probing )
+   {
+      SCIP_CALL( SCIPprobdataAgeColumns(scip, probdata, pricerdata->lpTestDuals, pricerdata->lpVehicleDuals,
+            pricerdata->maxage, &ndeleted) );
+      pricerdata->ndeleted += ndeleted;
+      pricerdata->nrounds++;
+   }
+
+   SCIP_CALL( pricePool(scip, pricerdata, probdata, &ncols) );
+   if( ncols > 0 )
+   {
+      *result = SCIP_SUCCESS;
+      return SCIP_OKAY;
+   }
+
+   /* the first round at a node reuses the columns its parent left */
+   if( !farkas && !probing && pricerdata->warmNode != SCIPnodeGetNumber(SCIPgetCurrentNode(scip)) )
+   {
+      NODESTATE* state = findParentState(scip, pricerdata);
+
+      pricerdata->warmNode = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+      if( state != NULL )
+      {
+         pricerdata->nwarmnodes++;
+         SCIP_CALL( warmStart(scip, pricerdata, probdata, state, &ncols) );
+         if( ncols > 0 )
+         {
+            *result = SCIP_SUCCESS;
+            return SCIP_OKAY;
+         }
+      }
+   }
+
+   /* the center is the best point of the node; a new node starts from the last duals of its parent, or from its
+    * first LP duals */
+   nodebound = -SCIPinfinity(scip);
+   alpha = 0.0;
+   smoothing = !farkas && !probing && pricerdata->smoothing > 0.0;
+   if( smoothing )
+   {
+      SCIP_Longint node = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+
+      if( pricerdata->centerNode != node )
+      {
+         NODESTATE* state = findParentState(scip, pricerdata);
+
+         /* a child is smoothed toward the last duals of its parent right away */
+         if( state != NULL )
+         {
+            BMScopyMemoryArray(pricerdata->centerTestDuals, state->testDuals, pricerdata->numTests);
+            BMScopyMemoryArray(pricerdata->centerVehicleDuals, state->vehicleDuals, pricerdata->numVehicles);
+            alpha = pricerdata->smoothing;
+         }
+         else
+         {
+            BMScopyMemoryArray(pricerdata->centerTestDuals, pricerdata->lpTestDuals, pricerdata->numTests);
+            BMScopyMemoryArray(pricerdata->centerVehicleDuals, pricerdata->lpVehicleDuals, pricerdata->numVehicles);
+         }
+         pricerdata->centerBound = -SCIPinfinity(scip);
+         pricerdata->centerNode = node;
+      }
+      else
+         alpha = pricerdata->smoothing;
+   }
+
+   /* on a misprice the center weight drops to 1 - k (1 - alpha) in the k-th run, until it is 0 */
+   for( int k = 1; ; ++k )
+   {
+      SCIP_Real weight = MAX(0.0, 1.0 - k * (1.0 - alpha));
+
+      setPricingDuals(scip, pricerdata, weight);
+      if( weight > 0.0 )
+         pricerdata->nsmoothed++;
+
+      SCIP_CALL( runStages(scip, pricerdata, probdata, &ncols, &complete) );
+
+      /* an exhaustive stage gives the Lagrangian bound at the priced duals, whatever they are */
+      if( complete && !farkas )
+      {
+         SCIP_Real bound = lagrangeBound(scip, pricerdata, probdata);
+
+         nodebound = MAX(nodebound, bound);
+         if( smoothing && bound > pricerdata->centerBound )
+         {
+            BMScopyMemoryArray(pricerdata->centerTestDuals, pricerdata->testDuals, pricerdata->numTests);
+            BMScopyMemoryArray(pricerdata->centerVehicleDuals, pricerdata->vehicleDuals, pricerdata->numVehicles);
+            pricerdata->centerBound = bound;
+            pricerdata->ncenters++;
+         }
+      }
+
+      if( ncols > 0 || weight == 0.0 )
+         break;
+
+      pricerdata->nmispriced++;
+   }
+
+   if( smoothing )
+      nodebound = MAX(nodebound, pricerdata->centerBound);
+
+   /* with an integral objective, pricing cannot raise the rounded bound of the node any more once the rounded
+    * Lagrangian bound reaches the LP value, which only decreases */
+   if( !farkas && !probing && !SCIPisInfinity(scip, -nodebound) )
+   {
+      SCIP_Real lpobj = SCIPgetLPObjval(scip);
+
+      *lowerbound = nodebound;
+      pricerdata->nbounds++;
+
+      if( pricerdata->stopearly && ncols > 0 && (SCIPisObjIntegral(scip)
+            ? SCIPisFeasGE(scip, SCIPfeasCeil(scip, nodebound), SCIPfeasCeil(scip, lpobj))
+            : SCIPisGE(scip, nodebound, lpobj)) )
+      {
+         SCIPdebugMessage("stop pricing: Lagrangian bound %g, LP value %g\n", nodebound, lpobj);
+         *stopearly = TRUE;
+         pricerdata->nstopped++;
+      }
+   }
+
+   /* a node is only cut off as infeasible if the exact stage found no column that repairs its LP */
+   if( farkas && ncols == 0 && !complete )
+   {
+      SCIP_CALL( priceStage(scip, pricerdata, probdata, STAGE_EXACT, &ncols, &complete) );
+   }
+
+   /* only an exhaustive last stage at the LP duals proves that no column has negative reduced cost */
+   if( ncols == 0 && !complete )
+      *result = SCIP_DIDNOTRUN;
+   else
+      *result = SCIP_SUCCESS;
+
+   return SCIP_OKAY;
+}
+
+/** reduced cost pricing method of variable pricer for feasible LPs */
+static
+SCIP_DECL_PRICERREDCOST(pricerRedcostTP3S)
+{  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   SCIP_CALL( priceColumns(scip, pricerdata, FALSE, lowerbound, stopearly, result) );
+
+   return SCIP_OKAY;
+}
+
+/** Farkas pricing method of variable pricer for infeasible LPs; decisions that enforce a test or an order on a vehicle
+ *  fix all columns that break them to zero, which can leave the master LP of a node without a cover for a test */
 static
 SCIP_DECL_PRICERFARKAS(pricerFarkasTP3S)
 {  /*lint --e{715}*/
+   SCIP_PRICERDATA* pricerdata;
+
+   assert(scip != NULL);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   SCIP_CALL( priceColumns(scip, pricerdata, TRUE, NULL, NULL, result) );
+
+   return SCIP_OKAY;
+}
+
+/** creates the tp3s variable pricer and includes it in SCIP */
+SCIP_RETCODE SCIPincludePricerTP3S(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PRICERDATA* pricerdata;
+   SCIP_PRICER* pricer;
+
+   /* create tp3s variable pricer data */
+   SCIP_CALL( SCIPallocMemory(scip, &pricerdata) );
+
+   pricerdata->sameDiffhdlr = NULL;
+   pricerdata->testOnVehiclehdlr = NULL;
+   pricerdata->testOrderhdlr = NULL;
+   pricerdata->testConss = NULL;
+   pricerdata->vehicleConss = NULL;
+   pricerdata->testArr = NULL;
+   pricerdata->vehicleArr = NULL;
+   pricerdata->rehitRules = NULL;
+   pricerdata->testDuals = NULL;
+   pricerdata->vehicleDuals = NULL;
+   pricerdata->classDuals = NULL;
+   pricerdata->costWeight = 1.0;
+   pricerdata->classResults = NULL;
+   pricerdata->classStatus = NULL;
+   pricerdata->releaseClass = NULL;
+   pricerdata->numReleaseClasses = 0;
+   pricerdata->vehicleClass = NULL;
+   pricerdata->classVehicle = NULL;
+   pricerdata->numClasses = 0;
+   pricerdata->nwords = 0;
+   pricerdata->forbidden = NULL;
+   pricerdata->hasForbidden = NULL;
+   pricerdata->nodeRehits = NULL;
+   pricerdata->splitPairs = FALSE;
+   pricerdata->vehicleRehits = NULL;
+   pricerdata->ownRehits = NULL;
+   pricerdata->partners = NULL;
+   pricerdata->mergedPairs = FALSE;
+   pricerdata->resultCols = 0;
+   pricerdata->pool = NULL;
+   pricerdata->numTests = 0;
+   pricerdata->numVehicles = 0;
+   pricerdata->stages = NULL;
+   pricerdata->ndeleted = 0;
+   pricerdata->nrestored = 0;
+   pricerdata->lpTestDuals = NULL;
+   pricerdata->lpVehicleDuals = NULL;
+   pricerdata->centerTestDuals = NULL;
+   pricerdata->centerVehicleDuals = NULL;
+   pricerdata->centerBound = 0.0;
+   pricerdata->centerNode = -1;
+   pricerdata->smoothed = FALSE;
+   pricerdata->nrounds = 0;
+   pricerdata->nsmoothed = 0;
+   pricerdata->nmispriced = 0;
+   pricerdata->ncenters = 0;
+   pricerdata->nbounds = 0;
+   pricerdata->nstopped = 0;
+   pricerdata->nodeStates = NULL;
+   pricerdata->nextState = 0;
+   pricerdata->warmNode = -1;
+   pricerdata->nwarmnodes = 0;
+   pricerdata->nwarmcols = 0;
+
+   for( int s = 0; s < NSTAGES; ++s )
+   {
+      SCIP_CALL( SCIPcreateClock(scip, &pricerdata->stageClocks[s]) );
+      pricerdata->stageCalls[s] = 0;
+      pricerdata->stageCols[s] = 0;
+   }
+
+   /* include variable pricer */
+   SCIP_CALL( SCIPincludePricerBasic(scip, &pricer, PRICER_NAME, PRICER_DESC, PRICER_PRIORITY, PRICER_DELAY,
+         pricerRedcostTP3S, pricerFarkasTP3S, pricerdata) );
+
+   SCIP_CALL( SCIPsetPricerFree(scip, pricer, pricerFreeTP3S) );
+   SCIP_CALL( SCIPsetPricerInit(scip, pricer, pricerInitTP3S) );
+   SCIP_CALL( SCIPsetPricerExitsol(scip, pricer, pricerExitsolTP3S) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/maxcols",
+         "maximal number of columns added per vehicle in one pricing round",
+         &pricerdata->maxcols, FALSE, DEFAULT_MAXCOLS, 1, INT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddLongintParam(scip, "pricers/tp3s/maxlabels",
+         "maximal number of labels created per vehicle in one pricing round (-1: no limit)",
+         &pricerdata->maxlabels, FALSE, DEFAULT_MAXLABELS, -1LL, SCIP_LONGINT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddStringParam(scip, "pricers/tp3s/stages",
+         "pricing stages in the order they are tried, each only if the ones before found nothing "
+         "('g'reedy insertion, 't'runcated labeling, 'r'estricted neighborhood labeling, 'e'xact labeling)",
+         &pricerdata->stages, FALSE, DEFAULT_STAGES, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/threads",
+         "number of threads the vehicles are priced on (0: one per core)",
+         &pricerdata->nthreads, FALSE, DEFAULT_THREADS, 0, INT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/maxpertest",
+         "maximal number of labels kept per last test in truncated labeling",
+         &pricerdata->maxpertest, FALSE, DEFAULT_MAXPERTEST, 1, INT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/neighbors",
+         "number of cheapest successors a label is extended by in restricted neighborhood labeling",
+         &pricerdata->neighbors, FALSE, DEFAULT_NEIGHBORS, 1, INT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddRealParam(scip, "pricers/tp3s/smoothing",
+         "weight of the stability center in the duals the subproblems are solved with (Wentges smoothing, 0: off)",
+         &pricerdata->smoothing, FALSE, DEFAULT_SMOOTHING, 0.0, 0.99, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/tp3s/stopearly",
+         "should pricing at a node stop once the Lagrangian bound, rounded up for an integral objective, reaches the "
+         "LP value?",
+         &pricerdata->stopearly, FALSE, DEFAULT_STOPEARLY, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/maxage",
+         "number of pricing rounds a column may stay out of the LP before it is deleted and moved to the pool "
+         "(-1: never delete)",
+         &pricerdata->maxage, FALSE, DEFAULT_MAXAGE, -1, INT_MAX, NULL, NULL) );
 
-   /** @note In case of this binpacking example, the master LP should not get infeasible after branching, because of the
-    *        way branching is performed. Therefore, the Farkas pricing is not implemented.
-    *        1. In case of Ryan/Foster branching, the two items are selected in a way such that the sum of the LP values
-    *           of all columns/packings containing both items is fractional. Hence, it exists at least one
-    *           column/packing which contains both items and also at least one column/packing for each item containing
-    *           this but not the other item. That means, branching in the "same" direction stays LP feasible since there
-    *           exists at least one column/packing with both items and branching in the "differ" direction stays LP
-    *           feasible since there exists at least one column/packing containing one item, but not the other.
-    *        2. In case of variable branching, we only branch on fractional variables. If a variable is fixed to one,
-    *           there is no issue.  If a variable is fixed to zero, then we know that for each item which is part of
-    *           that column/packing, there exists at least one other column/packing containing this particular item due
-    *           to the covering constraints.
-    */
-   SCIPwarningMessage(scip, "Current master LP is infeasible, but Farkas pricing was not implemented\n");
-   SCIPABORT();
-
-   return SCIP_OKAY; /*lint !e527*/
+   /* read by the problem data when the master problem is built */
+   SCIP_CALL( SCIPaddIntParam(scip, "pricers/tp3s/poolsize",
+         "maximal number of deleted columns kept in the pool for repricing",
+         NULL, FALSE, DEFAULT_POOLSIZE, 0, INT_MAX, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/tp3s/aggregatevehicles",
+         "should vehicles with equal release share one capacity row instead of one row per vehicle?",
+         NULL, FALSE, DEFAULT_AGGREGATE, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/tp3s/lazycolumns",
+         "should the master start from one greedy sequence per vehicle and slack columns instead of all columns with "
+         "one or two tests?",
+         NULL, FALSE, DEFAULT_LAZYCOLUMNS, NULL, NULL) );
+
+   SCIP_CALL( SCIPaddBoolParam(scip, "pricers/tp3s/namecolumns",
+         "should columns be named after their tests and vehicle (FALSE: short automatic names, which are not hashed "
+         "either if misc/usevartable is turned off as well)?",
+         NULL, FALSE, DEFAULT_NAMECOLUMNS, NULL, NULL) );
+
+   return SCIP_OKAY;
+}
+
+/** added problem specific data to pricer and activates pricer */
+SCIP_RETCODE SCIPpricerTP3SActivate(
+   SCIP* 					scip,
+   SCIP_CONS** 				testConss,
+   SCIP_CONS**				vehicleConss,
+   const TEST*				testArr,
+   const VEHICLE*			vehicleArr,
+   BITMATRIX*				rehitRules,
+   int 						numTests,
+   int 						numVehicles
+   )
+{
+   SCIP_PRICER* pricer;
+   SCIP_PRICERDATA* pricerdata;
+   int c;
+
+   assert(scip != NULL);
+   assert(testConss != NULL);
+   assert(vehicleConss != NULL);
+   assert(testArr != NULL);
+   assert(vehicleArr != NULL);
+   assert(rehitRules != NULL);
+   assert(numTests > 0);
+   assert(numVehicles > 0);
+
+   pricer = SCIPfindPricer(scip, PRICER_NAME);
+   assert(pricer != NULL);
+
+   pricerdata = SCIPpricerGetData(pricer);
+   assert(pricerdata != NULL);
+
+   /* find constraint handlers needed for pricing */
+   pricerdata->sameDiffhdlr = SCIPfindConshdlr(scip, "samediff");
+   pricerdata->testOnVehiclehdlr = SCIPfindConshdlr(scip, "testonvehicle");
+   pricerdata->testOrderhdlr = SCIPfindConshdlr(scip, "testorderonvehicle");
+
+   /* drop the data of a previously read problem */
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->testConss);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleConss);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->testArr);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleArr);
+   freePricingBuffers(scip, pricerdata);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->releaseClass);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->vehicleClass);
+   SCIPfreeMemoryArrayNull(scip, &pricerdata->classVehicle);
+   if( pricerdata->rehitRules != NULL )
+      bitmatrix_release(&pricerdata->rehitRules);
+
+   /* copy arrays */
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->testConss, testConss, numTests) );
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->vehicleConss, vehicleConss, numVehicles) );
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->testArr, testArr, numTests) );
+   SCIP_CALL( SCIPduplicateMemoryArray(scip, &pricerdata->vehicleArr, vehicleArr, numVehicles) );
+
+   /* the pricer keeps its own reference to the shared rehit matrix */
+   bitmatrix_capture(rehitRules);
+   pricerdata->rehitRules = rehitRules;
+
+   pricerdata->numTests = numTests;
+   pricerdata->numVehicles = numVehicles;
+
+   SCIP_CALL( computeClasses(scip, pricerdata) );
+
+   /* capture all constraints */
+   for( c = 0; c < numTests; ++c )
+   {
+      SCIP_CALL( SCIPcaptureCons(scip, testConss[c]) );
+   }
+   for( c = 0; c < numVehicles; ++c )
+   {
+      SCIP_CALL( SCIPcaptureCons(scip, vehicleConss[c]) );
+   }
+
+   /* activate pricer */
+   SCIP_CALL( SCIPactivatePricer(scip, pricer) );
+
+   return SCIP_OKAY;
 }
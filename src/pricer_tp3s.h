@@ -2,8 +2,10 @@
 #define _SCIP_PRICER_TP3S_H_ 
 
 #include "scip/scip.h"
+#include "data_structure.h"
+#include "bitmatrix.h"
 
-/** creates the binpacking variable pricer and includes it in SCIP */
+/** creates the tp3s variable pricer and includes it in SCIP */
 extern
 SCIP_RETCODE SCIPincludePricerTP3S(
    SCIP*                 scip                /**< SCIP data structure */
@@ -11,15 +13,16 @@ SCIP_RETCODE SCIPincludePricerTP3S(
 
 
 
-/** added problem specific data to pricer and activates pricer */
+/** added problem specific data to pricer and activates pricer; vehicleConss and vehicleArr hold one entry per
+ *  vehicle row, which stands for a whole vehicle class in the aggregated master */
 extern
 SCIP_RETCODE SCIPpricerTP3SActivate(
    SCIP* 					scip,
-   SCIP** 					testConss,
-   SCIP**					vehicleConss,
-   TETS*					testArr,
-   VEHICLE*					vehicleArr,
-   int**					rehitRules,
+   SCIP_CONS** 				testConss,
+   SCIP_CONS**				vehicleConss,
+   const TEST*				testArr,
+   const VEHICLE*			vehicleArr,
+   BITMATRIX*				rehitRules,
    int 						numTests,
    int 						numVehicles
    );
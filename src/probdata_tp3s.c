@@ -1,25 +1,66 @@
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "pricer_tp3s.h"
+#include "schedule.h"
+#include "list_schedule.h"
+#include "col_arena.h"
+#include "cons_samediff.h"
+#include "cons_testonvehicle.h"
+#include "cons_testorderonvehicle.h"
 #include "scip/cons_setppc.h"
+#include "scip/cons_linear.h"
 #include "scip/scip.h"
 
 #define EVENTHDLR_NAME         "addedvar"
 #define EVENTHDLR_DESC         "event handler for catching added variables"
 
+#define COLUMN_CHUNKBYTES      (1 << 20) /* bytes of column data allocated at once */
+
 struct  SCIP_ProbData
 {
 	SCIP_VAR**			vars;
 	SCIP_CONS** 		testConss;
 	SCIP_CONS**			vehicleConss;
 
-	TEST*				tests;
-	VEHICLE*			vehicles;
-	int**				rehits;
+	const TEST*			tests;
+	const VEHICLE*		vehicles;
+	BITMATRIX*			rehits;			/* shared by the original and the transformed problem */
+	COLARENA*			columns;		/* data of all columns, shared like rehits and freed with the last problem data */
 	int					numTests;
 	int 				numVehicles;
+	SCIP_Bool			ownsdata;		/* are tests and vehicles owned or used in place? */
+
+	/* vehicles with the same release are interchangeable and form a class; the
+	 * class vehicle carries the release and the id of the first member */
+	VEHICLE*			classes;
+	int*				classSizes;
+	int*				vehicleClass;	/* class of each vehicle */
+	int					numClasses;
+	SCIP_Bool			aggregated;		/* is there one capacity row per class instead of one row per vehicle? */
+	SCIP_Bool			namedColumns;	/* do columns get names, or the automatic ones of SCIP? */
+	SCIP_Real			slackCost;		/* cost of the slack column of each test, infinity without slacks */
+	SCIP_Bool			pendingRows;	/* are the rows still to be created, with all columns of the initial block? */
 
 	int 				nvars;
 	int 				varssize;
+	int*				ages;			/* pricing rounds each column has spent outside the LP, parallel to vars */
+
+	/* columns deleted from the problem keep their record in the column arena and wait in the pool, oldest first,
+	 * until the pricer finds them attractive again; their slots in vars are closed at the end of each aging round,
+	 * which moves the positions in the inverted indices and makes the branching constraints propagate again */
+	SCIP_VARDATA**		pool;
+	int					npool;
+	int					poolsize;
+	int					maxpool;		/* largest number of columns the pool keeps */
+
+	/* inverted indices: the positions in vars of the columns serving a test and of the columns of a vehicle row,
+	 * in increasing order, so that propagation only looks at the columns a branching decision can affect */
+	int**				testCols;
+	int*				ntestCols;
+	int*				testColsSize;
+	int**				vehicleCols;
+	int*				nvehicleCols;
+	int*				vehicleColsSize;
 };
 
 
@@ -41,6 +82,281 @@ SCIP_DECL_EVENTEXEC(eventExecAddedVar)
 }
 
 
+/** number of vehicle rows: one per vehicle, or one per class in the aggregated formulation */
+static
+int numVehicleRows(
+	SCIP_PROBDATA*	probdata
+	)
+{
+	return probdata->aggregated ? probdata->numClasses : probdata->numVehicles;
+}
+
+/** the vehicle a vehicle row stands for; in the aggregated formulation the class vehicle */
+static
+const VEHICLE* rowVehicle(
+	SCIP_PROBDATA*	probdata,
+	int				row
+	)
+{
+	return probdata->aggregated ? &probdata->classes[row] : &probdata->vehicles[row];
+}
+
+/** groups the vehicles by release, the classes are numbered in order of their first vehicle */
+static
+SCIP_RETCODE computeVehicleClasses(
+	SCIP*			scip,
+	const VEHICLE*	vehicles,
+	int				numVehicles,
+	VEHICLE*		classes,
+	int*			classSizes,
+	int*			vehicleClass,
+	int*			numClasses
+	)
+{
+	*numClasses = 0;
+
+	for (int v = 0; v < numVehicles; ++v)
+	{
+		int k;
+
+		for (k = 0; k < *numClasses && classes[k].release != vehicles[v].release; ++k)
+			;
+
+		if (k == *numClasses)
+		{
+			classes[k] = vehicles[v];
+			classSizes[k] = 0;
+			(*numClasses)++;
+		}
+
+		classSizes[k]++;
+		vehicleClass[v] = k;
+	}
+
+	return SCIP_OKAY;
+}
+
+/** appends a column to one list of an inverted index */
+static
+SCIP_RETCODE appendColumn(
+	SCIP*			scip,
+	int**			cols,
+	int*			ncols,
+	int*			colsSize,
+	int				pos
+	)
+{
+	if (*ncols == *colsSize)
+	{
+		*colsSize = MAX(8, *colsSize * 2);
+		SCIP_CALL( SCIPreallocMemoryArray(scip, cols, *colsSize) );
+	}
+
+	(*cols)[(*ncols)++] = pos;
+
+	return SCIP_OKAY;
+}
+
+/** makes room for need columns in one list of an inverted index */
+static
+SCIP_RETCODE reserveColumns(
+	SCIP*			scip,
+	int**			cols,
+	int*			colsSize,
+	int				need
+	)
+{
+	if (need > *colsSize)
+	{
+		*colsSize = MAX(need, *colsSize * 2);
+		SCIP_CALL( SCIPreallocMemoryArray(scip, cols, *colsSize) );
+	}
+
+	return SCIP_OKAY;
+}
+
+/** adds the column at position pos of vars to the inverted indices of its tests and its vehicle row */
+static
+SCIP_RETCODE indexColumn(
+	SCIP*			scip,
+	SCIP_PROBDATA*	probdata,
+	int				pos
+	)
+{
+	SCIP_VARDATA* vardata;
+	int* consids;
+	int nconsids;
+	int v;
+
+	vardata = SCIPvarGetData(probdata->vars[pos]);
+	assert(vardata != NULL);
+
+	consids = SCIPvardataGetConsids(vardata);
+	nconsids = SCIPvardataGetNConsids(vardata);
+	v = SCIPvardataGetVehicleConsids(vardata);
+
+	for (int i = 0; i < nconsids; ++i)
+	{
+		int t = consids[i];
+
+		SCIP_CALL( appendColumn(scip, &probdata->testCols[t], &probdata->ntestCols[t], &probdata->testColsSize[t], pos) );
+	}
+
+	SCIP_CALL( appendColumn(scip, &probdata->vehicleCols[v], &probdata->nvehicleCols[v], &probdata->vehicleColsSize[v], pos) );
+
+	return SCIP_OKAY;
+}
+
+/** moves the positions in one list of an inverted index to the compacted variable array; the positions of deleted
+ *  columns are dropped, the order is kept */
+static
+void remapColumns(
+	int*			cols,
+	int*			ncols,
+	const int*		newpos
+	)
+{
+	int n = 0;
+
+	for (int i = 0; i < *ncols; ++i)
+	{
+		if (newpos[cols[i]] >= 0)
+			cols[n++] = newpos[cols[i]];
+	}
+	*ncols = n;
+}
+
+/** marks every branching constraint as unpropagated; they remember how many columns of vars they checked, which
+ *  says nothing once the columns moved */
+static
+void resetPropagation(
+	SCIP*			scip
+	)
+{
+	SCIP_CONSHDLR* conshdlr;
+	SCIP_CONS** conss;
+
+	conshdlr = SCIPfindConshdlr(scip, "samediff");
+	if (conshdlr != NULL)
+	{
+		conss = SCIPconshdlrGetConss(conshdlr);
+		for (int c = 0; c < SCIPconshdlrGetNConss(conshdlr); ++c)
+			SCIPresetPropagatedSamediff(scip, conss[c]);
+	}
+
+	conshdlr = SCIPfindConshdlr(scip, "testonvehicle");
+	if (conshdlr != NULL)
+	{
+		conss = SCIPconshdlrGetConss(conshdlr);
+		for (int c = 0; c < SCIPconshdlrGetNConss(conshdlr); ++c)
+			SCIPresetPropagatedTestOnVehicle(scip, conss[c]);
+	}
+
+	conshdlr = SCIPfindConshdlr(scip, "testorderonvehicle");
+	if (conshdlr != NULL)
+	{
+		conss = SCIPconshdlrGetConss(conshdlr);
+		for (int c = 0; c < SCIPconshdlrGetNConss(conshdlr); ++c)
+			SCIPresetPropagatedTestOrderOnVehicle(scip, conss[c]);
+	}
+}
+
+/** closes the slots that deleted columns left in vars, keeping the order of the other columns, so that the array
+ *  only holds the columns of the problem; the inverted indices and the positions in the column records move along */
+static
+SCIP_RETCODE compactColumns(
+	SCIP*			scip,
+	SCIP_PROBDATA*	probdata
+	)
+{
+	int* newpos;
+	int nvars;
+
+	SCIP_CALL( SCIPallocBufferArray(scip, &newpos, probdata->nvars) );
+
+	nvars = 0;
+	for (int i = 0; i < probdata->nvars; ++i)
+	{
+		if (probdata->vars[i] == NULL)
+		{
+			newpos[i] = -1;
+			continue;
+		}
+
+		newpos[i] = nvars;
+		probdata->vars[nvars] = probdata->vars[i];
+		probdata->ages[nvars] = probdata->ages[i];
+		SCIPvardataSetPos(SCIPvarGetData(probdata->vars[nvars]), nvars);
+		nvars++;
+	}
+	probdata->nvars = nvars;
+
+	for (int t = 0; t < probdata->numTests; ++t)
+		remapColumns(probdata->testCols[t], &probdata->ntestCols[t], newpos);
+	for (int v = 0; v < numVehicleRows(probdata); ++v)
+		remapColumns(probdata->vehicleCols[v], &probdata->nvehicleCols[v], newpos);
+
+	SCIPfreeBufferArray(scip, &newpos);
+
+	resetPropagation(scip);
+
+	return SCIP_OKAY;
+}
+
+/** puts the record of a deleted column into the pool; a full pool forgets its oldest quarter first */
+static
+SCIP_RETCODE poolColumn(
+	SCIP*			scip,
+	SCIP_PROBDATA*	probdata,
+	SCIP_VARDATA*	vardata
+	)
+{
+	if (probdata->maxpool == 0)
+		return SCIP_OKAY;
+
+	if (probdata->npool == probdata->maxpool)
+	{
+		int ndrop = MAX(1, probdata->maxpool / 4);
+
+		BMSmoveMemoryArray(probdata->pool, probdata->pool + ndrop, probdata->npool - ndrop);
+		probdata->npool -= ndrop;
+	}
+
+	if (probdata->npool == probdata->poolsize)
+	{
+		probdata->poolsize = MIN(probdata->maxpool, MAX(100, probdata->poolsize * 2));
+		SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->pool, probdata->poolsize) );
+	}
+
+	probdata->pool[probdata->npool++] = vardata;
+
+	return SCIP_OKAY;
+}
+
+/** empties the slot of a deleted column and moves its record to the pool; the slot stays in the inverted indices
+ *  until compactColumns() closes it */
+static
+SCIP_RETCODE retireColumn(
+	SCIP*			scip,
+	SCIP_PROBDATA*	probdata,
+	int				pos
+	)
+{
+	SCIP_VARDATA* vardata;
+
+	vardata = SCIPvarGetData(probdata->vars[pos]);
+	assert(vardata != NULL);
+	assert(SCIPvardataGetPos(vardata) == pos);
+
+	SCIPvardataSetPos(vardata, -1);
+	SCIP_CALL( poolColumn(scip, probdata, vardata) );
+
+	SCIP_CALL( SCIPreleaseVar(scip, &probdata->vars[pos]) );
+	assert(probdata->vars[pos] == NULL);
+
+	return SCIP_OKAY;
+}
+
 static
 SCIP_RETCODE probdataCreate(
 	SCIP*			scip,
@@ -51,9 +367,16 @@ SCIP_RETCODE probdataCreate(
 	int  			nvars,
 	int 			numTests,
 	int 			numVehicles,
-	TEST*			tests,
-	VEHICLE*		vehicles,
-	int**			rehits
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
+	BITMATRIX*		rehits,
+	COLARENA*		columns,
+	SCIP_Bool		copydata,
+	VEHICLE*		classes,
+	int*			classSizes,
+	int*			vehicleClass,
+	int				numClasses,
+	SCIP_Bool		aggregated
 	)
 {
 	assert(scip != NULL);
@@ -61,25 +384,68 @@ SCIP_RETCODE probdataCreate(
 
 	SCIP_CALL( SCIPallocMemory(scip, probdata));
 
+	SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->classes, classes, numClasses));
+	SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->classSizes, classSizes, numClasses));
+	SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->vehicleClass, vehicleClass, numVehicles));
+	(*probdata)->numClasses = numClasses;
+	(*probdata)->aggregated = aggregated;
+
 	if (nvars > 0)
 	{
 		SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->vars, vars, nvars));
+		SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->ages, nvars));
 	} 
 	else 
+	{
 		(*probdata)->vars = NULL;
+		(*probdata)->ages = NULL;
+	}
 
-	SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->tests, tests, numTests));
-	SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->vehicles, vehicles, numVehicles));
-	SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->rehits, rehits, numTests));
-	for (int i = 0; i < numTests; ++i)
+	(*probdata)->slackCost = SCIPinfinity(scip);
+	(*probdata)->pendingRows = FALSE;
+	(*probdata)->pool = NULL;
+	(*probdata)->npool = 0;
+	(*probdata)->poolsize = 0;
+	(*probdata)->maxpool = 0;
+
+	SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->testConss, testConss, numTests));
+	SCIP_CALL( SCIPduplicateMemoryArray(scip, &(*probdata)->vehicleConss, vehicleConss, aggregated ? numClasses : numVehicles));
+
+	/* tests and vehicles of a mapped instance file are used without copying them */
+	if (copydata)
+	{
+		SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->tests, tests, numTests));
+		SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->vehicles, vehicles, numVehicles));
+	}
+	else
 	{
-		SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->rehits[i], rehits[i], numTests));
+		(*probdata)->tests = tests;
+		(*probdata)->vehicles = vehicles;
 	}
 
+	/* the rehit rules never change, so all problem data share one matrix */
+	bitmatrix_capture(rehits);
+	(*probdata)->rehits = rehits;
+	colarena_capture(columns);
+	(*probdata)->columns = columns;
+
 	(*probdata)->nvars = nvars;
 	(*probdata)->numTests = numTests;
 	(*probdata)->numVehicles = numVehicles;
 	(*probdata)->varssize = nvars;
+	(*probdata)->ownsdata = copydata;
+
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->testCols, numTests));
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->ntestCols, numTests));
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->testColsSize, numTests));
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->vehicleCols, numVehicleRows(*probdata)));
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->nvehicleCols, numVehicleRows(*probdata)));
+	SCIP_CALL( SCIPallocClearMemoryArray(scip, &(*probdata)->vehicleColsSize, numVehicleRows(*probdata)));
+
+	for (int i = 0; i < nvars; ++i)
+	{
+		SCIP_CALL( indexColumn(scip, *probdata, i) );
+	}
 
 	return SCIP_OKAY;
 }
@@ -107,23 +473,39 @@ SCIP_RETCODE probdataFree(
       SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->testConss[i]) );
    }
 
-   for (int i = 0; i < (*probdata)->numVehicles; ++i)
+   for (int i = 0; i < numVehicleRows(*probdata); ++i)
    {
       SCIP_CALL( SCIPreleaseCons(scip, &(*probdata)->vehicleConss[i]));
    }
 
    /* free memory of arrays */
-   SCIPfreeMemoryArray(scip, &(*probdata)->vars);
+   SCIPfreeMemoryArrayNull(scip, &(*probdata)->vars);
+   SCIPfreeMemoryArrayNull(scip, &(*probdata)->ages);
+   SCIPfreeMemoryArrayNull(scip, &(*probdata)->pool);
    SCIPfreeMemoryArray(scip, &(*probdata)->testConss);
    SCIPfreeMemoryArray(scip, &(*probdata)->vehicleConss);
-   
-   SCIPfreeMemoryArray(scip, &(*probdata)->tests);
-   SCIPfreeMemoryArray(scip, &(*probdata)->vehicles);
+   SCIPfreeMemoryArray(scip, &(*probdata)->classes);
+   SCIPfreeMemoryArray(scip, &(*probdata)->classSizes);
+   SCIPfreeMemoryArray(scip, &(*probdata)->vehicleClass);
+
    for (int i = 0; i < (*probdata)->numTests; ++i)
+      SCIPfreeMemoryArrayNull(scip, &(*probdata)->testCols[i]);
+   for (int i = 0; i < numVehicleRows(*probdata); ++i)
+      SCIPfreeMemoryArrayNull(scip, &(*probdata)->vehicleCols[i]);
+   SCIPfreeMemoryArray(scip, &(*probdata)->testCols);
+   SCIPfreeMemoryArray(scip, &(*probdata)->ntestCols);
+   SCIPfreeMemoryArray(scip, &(*probdata)->testColsSize);
+   SCIPfreeMemoryArray(scip, &(*probdata)->vehicleCols);
+   SCIPfreeMemoryArray(scip, &(*probdata)->nvehicleCols);
+   SCIPfreeMemoryArray(scip, &(*probdata)->vehicleColsSize);
+   
+   if ((*probdata)->ownsdata)
    {
-   		SCIPfreeMemoryArray(scip, &(*probdata)->rehits[i]);
+      SCIPfreeMemoryArray(scip, &(*probdata)->tests);
+      SCIPfreeMemoryArray(scip, &(*probdata)->vehicles);
    }
-   SCIPfreeMemoryArray(scip, &(*probdata)->rehits);
+   bitmatrix_release(&(*probdata)->rehits);
+   colarena_release(&(*probdata)->columns);
 
    /* free probdata */
    SCIPfreeMemory(scip, probdata);
@@ -131,182 +513,162 @@ SCIP_RETCODE probdataFree(
    return SCIP_OKAY;
 }
 
+/** adds every single test column and every compatible pair column on every vehicle row as one block */
 static
 SCIP_RETCODE createInitialColumns(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_PROBDATA*        probdata            /**< problem data */
    )
 {
-	SCIP_CONS** testConss;
-	SCIP_CONS** vehicleConss;
-   SCIP_VARDATA* vardata;
-	SCIP_VAR* var;
-
-	char name[SCIP_MAXSTRLEN];
-
-	int numTests, numVehicles;
-	TEST* tests;
-	VEHICLE* vehicles;
-	int** rehits;
-
-	testConss = probdata->testConss;
-	vehicleConss = probdata->vehicleConss;
+	int numTests, numRows;
+	const TEST* tests;
+	BITMATRIX* rehits;
+	int* colTests;
+	int* colBeg;
+	int* colRows;
+	SCIP_Real* colCosts;
+	int npairs;
+	int ncols;
+	int nnz;
 
 	numTests = probdata->numTests;
-	numVehicles = probdata->numVehicles;
+	numRows = numVehicleRows(probdata);
 
 	tests = probdata->tests;
-	vehicles = probdata->vehicles;
 	rehits = probdata->rehits;
 
-	/* columns contains single test */
+	npairs = 0;
 	for (int i = 0; i < numTests; ++i)
-	{
-
-		for (int v = 0; v < numVehicles; ++v)
-		{
-         int vehicleRelease;
-         int testDur, testDeadline, testRelease;
-         int realRelease;
-         int cost;
-         int a;
-
-			(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "item_%d_on_vehicle_%d", i,v);
-
-         vehicleRelease = vehicles[v].release;
-         testDur = tests[i].dur;
-         testDeadline = tests[i].deadline;
-         testRelease = tests[i].release;
-
-			/* compute the cost of assignment */
-         realRelease = vehicleRelease < testRelease ? vehicleRelease : testRelease;
-         cost = realRelease + testDur - testDeadline;
-         cost = cost > 0 ? cost : 0;
-         cost += 50;
-
-			/* create variable */
-         SCIP_CALL( SCIPcreateVarTP3S(scip, &var, name, cost, TRUE, TRUE, NULL));
-
-			/* add variable to the problem */
-      	SCIP_CALL( SCIPaddVar(scip, var) );
-
-      	/* store variable in the problme data */
-      	SCIP_CALL( SCIPprobdataAddVar(scip, probdata, var) );
-
-      	/* add variable to corresponding set covering constraint */
-      	SCIP_CALL( SCIPaddCoefSetppc(scip, testConss[i], var) );
-      	SCIP_CALL( SCIPaddCoefSetppc(scip, vehicleConss[v], var));
-
+		npairs += bitset_popcount(bitmatrix_row(rehits, i), rehits->nwords) - bitmatrix_get(rehits, i, i);
 
-      	/* create the variable data for the variable; the variable data contains the information in which constraints the
-       	* variable appears */
-         a = i;
-         SCIP_CALL( SCIPvardataCreateTP3S(scip, &vardata, &a, 1, v));
+	ncols = (numTests + npairs) * numRows;
+	SCIP_CALL( SCIPallocBufferArray(scip, &colTests, (numTests + 2 * npairs) * numRows) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &colBeg, ncols + 1) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &colRows, ncols) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &colCosts, ncols) );
 
-       	/* add the variable data to the variable */
-      	SCIPvarSetData(var, vardata);
+	ncols = 0;
+	nnz = 0;
 
-
-      	/* change the upper bound of the binary variable to lazy since the upper bound is already enforced
-       		* due to the objective function the set covering constraint;
-       		* The reason for doing is that, is to avoid the bound of x <= 1 in the LP relaxation since this bound
-       		* constraint would produce a dual variable which might have a positive reduced cost
-       		*/
-      	SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
-
-      	/* release variable */
-      	SCIP_CALL( SCIPreleaseVar(scip, &var) );
+	/* columns contains single test */
+	for (int i = 0; i < numTests; ++i)
+	{
+		for (int v = 0; v < numRows; ++v)
+		{
+			colBeg[ncols] = nnz;
+			colTests[nnz++] = i;
+			colRows[ncols] = v;
+			colCosts[ncols] = sequence_cost(tests, colTests + colBeg[ncols], 1, rowVehicle(probdata, v)->release);
+			ncols++;
 		}
 	}
 
 	/* columns that contains two tests */
 	for (int i = 0; i < numTests; ++i)
 	{
-		for (int j = 0; j < numTests; ++j)
+		const uint64_t* successors = bitmatrix_row(rehits, i);
+
+		/* only visit the allowed successors of i, a word at a time */
+		for (int j = bitset_next(successors, rehits->nwords, 0); j >= 0; j = bitset_next(successors, rehits->nwords, j+1))
 		{
-			/* if self or not allowed by compatibility, then continue */
-			if (i==j || !rehits[i][j])
+			/* if self, then continue */
+			if (i==j)
 				continue;
-			for (int v = 0; v < numVehicles; ++v)
-			{
 
-            int vehicleRelease;
-            int realRelease;
-            int cost = 0;
-            int test1Dur, test1Release, test1Deadline;
-            int test2Dur, test2Release, test2Deadline;
-            int* consids;
-
-				(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "item_%d,%d_on_vehicle_%d", i,j,v);
-
-            vehicleRelease = vehicles[v].release;
-            
-            test1Dur = tests[i].dur;
-            test1Deadline = tests[i].deadline;
-            test1Release = tests[i].release;
-
-            test2Dur = tests[j].dur;
-            test2Deadline = tests[j].deadline;
-            test2Release = tests[j].release;
-
-				/* compute the cost of assignment */
-            realRelease = vehicleRelease < test1Release ? vehicleRelease : test1Release;
-            realRelease += test1Dur;
-            cost = realRelease - test1Deadline;
-            cost = cost > 0 ? cost : 0;
-
-            realRelease = realRelease < test2Release ? realRelease : test2Release;
-            realRelease += test2Dur;
-            cost += (realRelease - test2Deadline > 0) ? (realRelease - test2Deadline) : 0;
-
-				/* create variable */
-            SCIP_CALL( SCIPcreateVarTP3S(scip, &var, name, cost, TRUE, TRUE, NULL));
+			for (int v = 0; v < numRows; ++v)
+			{
+				colBeg[ncols] = nnz;
+				colTests[nnz++] = i;
+				colTests[nnz++] = j;
+				colRows[ncols] = v;
+				colCosts[ncols] = sequence_cost(tests, colTests + colBeg[ncols], 2, rowVehicle(probdata, v)->release);
+				ncols++;
+			}
+		}
+	}
+	colBeg[ncols] = nnz;
 
+	SCIP_CALL( SCIPprobdataAddColumns(scip, probdata, colTests, colBeg, colRows, colCosts, ncols, FALSE) );
 
-				/* add variable to the problem */
-	      	SCIP_CALL( SCIPaddVar(scip, var) );
+	SCIPfreeBufferArray(scip, &colCosts);
+	SCIPfreeBufferArray(scip, &colRows);
+	SCIPfreeBufferArray(scip, &colBeg);
+	SCIPfreeBufferArray(scip, &colTests);
 
-	      	/* store variable in the problme data */
-	      	SCIP_CALL( SCIPprobdataAddVar(scip, probdata, var) );
+	return SCIP_OKAY;
+}
 
-	      	/* add variable to corresponding set covering constraint */
-	      	SCIP_CALL( SCIPaddCoefSetppc(scip, testConss[i], var) );
-	      	SCIP_CALL( SCIPaddCoefSetppc(scip, testConss[j], var) );
-	      	SCIP_CALL( SCIPaddCoefSetppc(scip, vehicleConss[v], var));
+/** seeds the master with one greedy sequence per vehicle and one slack column per test instead of enumerating all
+ *  columns; the tests are appended in order of release to the vehicle where they add the least tardiness. The slacks
+ *  cost more than any schedule and keep the LP feasible under every branching decision; they carry no variable data
+ *  and are created with the rows */
+static
+SCIP_RETCODE createSeedColumns(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+	const TEST* tests = probdata->tests;
+	const VEHICLE* vehicles = probdata->vehicles;
+	int numTests = probdata->numTests;
+	int numVehicles = probdata->numVehicles;
+	int* releases;
+	int* order;
+	int* seqs;
+	int* lens;
+	int horizon;
+
+	SCIP_CALL( SCIPallocBufferArray(scip, &releases, numTests) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &order, numTests) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &seqs, numVehicles * numTests) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &lens, numVehicles) );
 
+	for (int i = 0; i < numTests; ++i)
+	{
+		releases[i] = (int) tests[i].release;
+		order[i] = i;
+	}
+	SCIPsortIntInt(releases, order, numTests);
 
-	      	/* create the variable data for the variable; the variable data contains the information in which constraints the
-	       		* variable appears */
-            SCIP_CALL( SCIPallocBufferArray(scip, &consids, 2));
-            consids[0] = i;
-            consids[1] = j;
-            SCIP_CALL( SCIPvardataCreateTP3S(scip, &vardata, consids, 2, v));
+	/* the tests that fit on no vehicle are left to the slack and the pricer */
+	if (list_schedule(tests, vehicles, numTests, numVehicles, probdata->rehits, order, seqs, lens) < 0)
+	{
+		SCIPfreeBufferArray(scip, &lens);
+		SCIPfreeBufferArray(scip, &seqs);
+		SCIPfreeBufferArray(scip, &order);
+		SCIPfreeBufferArray(scip, &releases);
+		return SCIP_NOMEMORY;
+	}
 
-	       	/* add the variable data to the variable */
-	      	SCIPvarSetData(var, vardata);
+	for (int v = 0; v < numVehicles; ++v)
+	{
+		const int* seq = seqs + v * numTests;
 
+		if (lens[v] == 0)
+			continue;
 
-	      	/* change the upper bound of the binary variable to lazy since the upper bound is already enforced
-	       		* due to the objective function the set covering constraint;
-	       		* The reason for doing is that, is to avoid the bound of x <= 1 in the LP relaxation since this bound
-	       		* constraint would produce a dual variable which might have a positive reduced cost
-	       		*/
-	      	SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
+		SCIP_CALL( SCIPprobdataAddColumn(scip, probdata, seq, lens[v], probdata->aggregated ? probdata->vehicleClass[v] : v,
+			sequence_cost(tests, seq, lens[v], vehicles[v].release), FALSE) );
+	}
 
-	      	/* release variable */
-	      	SCIP_CALL( SCIPreleaseVar(scip, &var) );
+	/* no schedule is more expensive than serving every test alone after all tests and vehicles are released */
+	horizon = 0;
+	for (int v = 0; v < numVehicles; ++v)
+		horizon = MAX(horizon, (int) vehicles[v].release);
+	for (int i = 0; i < numTests; ++i)
+		horizon = MAX(horizon, (int) tests[i].release);
+	for (int i = 0; i < numTests; ++i)
+		horizon += (int) tests[i].dur;
+	probdata->slackCost = (SCIP_Real) numTests * (SINGLE_TEST_COST + horizon) + 1.0;
 
-            SCIPfreeBufferArray(scip, &consids);
-			
-			}
-		}
-	}
+	SCIPfreeBufferArray(scip, &lens);
+	SCIPfreeBufferArray(scip, &seqs);
+	SCIPfreeBufferArray(scip, &order);
+	SCIPfreeBufferArray(scip, &releases);
 
 	return SCIP_OKAY;
-
 }
 
-
 /** frees user data of original problem (called when the original problem is freed) */
 static
 SCIP_DECL_PROBDELORIG(probdelorigTP3S)
@@ -327,11 +689,16 @@ SCIP_DECL_PROBTRANS(probtransTP3S)
    SCIP_CALL( probdataCreate(scip, targetdata, sourcedata->vars, 
    		sourcedata->testConss, sourcedata->vehicleConss,
         sourcedata->nvars, sourcedata->numTests, sourcedata->numVehicles,
-        sourcedata->tests, sourcedata->vehicles, sourcedata->rehits) );
+        sourcedata->tests, sourcedata->vehicles, sourcedata->rehits, sourcedata->columns, sourcedata->ownsdata,
+        sourcedata->classes, sourcedata->classSizes, sourcedata->vehicleClass, sourcedata->numClasses,
+        sourcedata->aggregated) );
+   (*targetdata)->namedColumns = sourcedata->namedColumns;
+   (*targetdata)->maxpool = sourcedata->maxpool;
+   (*targetdata)->slackCost = sourcedata->slackCost;
 
    /* transform all constraints */
    SCIP_CALL( SCIPtransformConss(scip, (*targetdata)->numTests, (*targetdata)->testConss, (*targetdata)->testConss) );
-   SCIP_CALL( SCIPtransformConss(scip, (*targetdata)->numVehicles, (*targetdata)->vehicleConss, (*targetdata)->vehicleConss) );
+   SCIP_CALL( SCIPtransformConss(scip, numVehicleRows(*targetdata), (*targetdata)->vehicleConss, (*targetdata)->vehicleConss) );
 
    /* transform all variables */
    SCIP_CALL( SCIPtransformVars(scip, (*targetdata)->nvars, (*targetdata)->vars, (*targetdata)->vars) );
@@ -385,22 +752,132 @@ SCIP_DECL_PROBEXITSOL(probexitsolTP3S)
    return SCIP_OKAY;
 }
 
-SCIP_RETCODE SCIPprobdataCreate(
+/** creates the covering row of every test and the capacity row of every vehicle row, each with all columns of the
+ *  initial block in one call; the inverted indices already list the columns of every row. In lazy mode every test
+ *  row also gets its slack column */
+static
+SCIP_RETCODE createRows(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_PROBDATA*        probdata            /**< problem data */
+   )
+{
+	SCIP_VAR** rowVars;
+	SCIP_Real* ones;
+	SCIP_Bool slacks;
+	int numRows;
+	int maxlen;
+	char name[SCIP_MAXSTRLEN];
+
+	assert(probdata->pendingRows);
+
+	numRows = numVehicleRows(probdata);
+	slacks = !SCIPisInfinity(scip, probdata->slackCost);
+
+	maxlen = 1;
+	for (int t = 0; t < probdata->numTests; ++t)
+		maxlen = MAX(maxlen, probdata->ntestCols[t] + 1);
+	for (int v = 0; v < numRows; ++v)
+		maxlen = MAX(maxlen, probdata->nvehicleCols[v]);
+
+	SCIP_CALL( SCIPallocBufferArray(scip, &rowVars, maxlen) );
+	SCIP_CALL( SCIPallocBufferArray(scip, &ones, maxlen) );
+	for (int k = 0; k < maxlen; ++k)
+		ones[k] = 1.0;
+
+	/* create set covering constraint for each item */
+	for (int t = 0; t < probdata->numTests; ++t)
+	{
+		SCIP_VAR* slack = NULL;
+		int n = 0;
+
+		if (slacks)
+		{
+			(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "slack_%d", probdata->tests[t].tid);
+			SCIP_CALL( SCIPcreateVarBasic(scip, &slack, name, 0.0, 1.0, probdata->slackCost, SCIP_VARTYPE_BINARY) );
+			SCIP_CALL( SCIPaddVar(scip, slack) );
+			SCIP_CALL( SCIPchgVarUbLazy(scip, slack, 1.0) );
+			rowVars[n++] = slack;
+		}
+		for (int i = 0; i < probdata->ntestCols[t]; ++i)
+			rowVars[n++] = probdata->vars[probdata->testCols[t][i]];
+
+		(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "test_%d", probdata->tests[t].tid);
+		SCIP_CALL( SCIPcreateConsBasicSetcover(scip, &probdata->testConss[t], name, n, rowVars) );
+
+		/* declare constraint modifiable for adding variables during pricing */
+		SCIP_CALL( SCIPsetConsModifiable(scip, probdata->testConss[t], TRUE) );
+		SCIP_CALL( SCIPaddCons(scip, probdata->testConss[t]) );
+
+		if (slack != NULL)
+		{
+			SCIP_CALL( SCIPreleaseVar(scip, &slack) );
+		}
+	}
+
+	for (int v = 0; v < numRows; ++v)
+	{
+		int n = probdata->nvehicleCols[v];
+
+		for (int i = 0; i < n; ++i)
+			rowVars[i] = probdata->vars[probdata->vehicleCols[v][i]];
+
+		if (probdata->aggregated)
+		{
+			/* one capacity row per class: at most as many sequences as the class has vehicles */
+			(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "vehicleclass_%d", probdata->classes[v].release);
+			SCIP_CALL( SCIPcreateConsBasicLinear(scip, &probdata->vehicleConss[v], name, n, rowVars, ones,
+				-SCIPinfinity(scip), (SCIP_Real) probdata->classSizes[v]) );
+		}
+		else
+		{
+			/* create the set packing constraint for each vehicle */
+			(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "vehicle_%d", probdata->vehicles[v].vid);
+			SCIP_CALL( SCIPcreateConsBasicSetpack(scip, &probdata->vehicleConss[v], name, n, rowVars) );
+		}
+		SCIP_CALL( SCIPsetConsModifiable(scip, probdata->vehicleConss[v], TRUE) );
+		SCIP_CALL( SCIPaddCons(scip, probdata->vehicleConss[v]) );
+	}
+
+	SCIPfreeBufferArray(scip, &ones);
+	SCIPfreeBufferArray(scip, &rowVars);
+
+	probdata->pendingRows = FALSE;
+
+	return SCIP_OKAY;
+}
+
+/** creates the master problem; with copydata FALSE the test and vehicle arrays are used in place */
+static
+SCIP_RETCODE createProb(
 	SCIP*			scip,
 	const char*		probname,
-	TEST*			tests,
-	VEHICLE*		vehicles,
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
 	int 			numTests,
 	int 			numVehicles,
-	int**			rehits)
+	BITMATRIX*		rehits,
+	SCIP_Bool		copydata)
 {
 	SCIP_PROBDATA* probdata;
 	SCIP_CONS** testConss;
 	SCIP_CONS** vehicleConss;
-	char name[SCIP_MAXSTRLEN];
+	VEHICLE* classes;
+	int* classSizes;
+	int* vehicleClass;
+	int numClasses;
+	SCIP_Bool aggregated;
+	SCIP_Bool lazy;
+	SCIP_Bool namedColumns;
+	int maxpool;
+	COLARENA* columns;
 
 	assert(scip != NULL);
 
+	SCIP_CALL( SCIPgetBoolParam(scip, "pricers/tp3s/aggregatevehicles", &aggregated) );
+	SCIP_CALL( SCIPgetBoolParam(scip, "pricers/tp3s/lazycolumns", &lazy) );
+	SCIP_CALL( SCIPgetBoolParam(scip, "pricers/tp3s/namecolumns", &namedColumns) );
+	SCIP_CALL( SCIPgetIntParam(scip, "pricers/tp3s/poolsize", &maxpool) );
+
 	/* if cannot find event handler, create the handler */
    	if( SCIPfindEventhdlr(scip, EVENTHDLR_NAME) == NULL )
    	{
@@ -421,39 +898,59 @@ SCIP_RETCODE SCIPprobdataCreate(
    	/* tell SCIP that the objective will be always integral */
    	SCIP_CALL( SCIPsetObjIntegral(scip) );
 
-   	SCIP_CALL( SCIPallocBufferArray(scip, &testConss, numTests));
-   	SCIP_CALL( SCIPallocBufferArray(scip, &vehicleConss, numVehicles));
+   	/* the rows are created after the initial block of columns, see createRows() */
+   	SCIP_CALL( SCIPallocClearBufferArray(scip, &testConss, numTests));
+   	SCIP_CALL( SCIPallocClearBufferArray(scip, &vehicleConss, numVehicles));
+   	SCIP_CALL( SCIPallocBufferArray(scip, &classes, numVehicles));
+   	SCIP_CALL( SCIPallocBufferArray(scip, &classSizes, numVehicles));
+   	SCIP_CALL( SCIPallocBufferArray(scip, &vehicleClass, numVehicles));
 
-   	/* create set covering constraint for each item */
-   	for (int i = 0; i < numTests; ++i)
-   	{
-   		(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "test_%d", tests[i].tid);
-   		SCIP_CALL( SCIPcreateConsBasicSetcover(scip, &testConss[i], name, 0, NULL) );
-   		SCIP_CALL( SCIPaddCons(scip, testConss[i]) );   
-   	}
+   	SCIP_CALL( computeVehicleClasses(scip, vehicles, numVehicles, classes, classSizes, vehicleClass, &numClasses) );
 
-   	/* create the set packing constraint for each vehicle */
-   	for (int i = 0; i < numVehicles; ++i)
-   	{
-   		(void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "vehicle_%d", tests[i].tid);
-   		SCIP_CALL( SCIPcreateConsBasicSetpack(scip, &vehicleConss[i], name, 0, NULL));
-   		SCIP_CALL( SCIPaddCons(scip, vehicleConss[i]));   
-   	}
+   	/* create problem data; it keeps its own reference to the column arena */
+   	columns = colarena_create(numTests, COLUMN_CHUNKBYTES);
+   	if (columns == NULL)
+   		return SCIP_NOMEMORY;
 
-   	/* create problem data */
    	SCIP_CALL( probdataCreate(scip, &probdata, NULL, testConss, vehicleConss,
    	 	0, numTests, numVehicles, 
-   	 	tests, vehicles, rehits) );
+   	 	tests, vehicles, rehits, columns, copydata,
+   	 	classes, classSizes, vehicleClass, numClasses, aggregated) );
 
-   	SCIP_CALL( createInitialColumns(scip, probdata) );
+   	colarena_release(&columns);
+   	probdata->namedColumns = namedColumns;
+   	probdata->maxpool = maxpool;
+   	probdata->pendingRows = TRUE;
+
+   	/* in lazy mode the root LP only grows with n + V, everything else is priced */
+   	if (lazy)
+   	{
+   		SCIP_CALL( createSeedColumns(scip, probdata) );
+   	}
+   	else
+   	{
+   		SCIP_CALL( createInitialColumns(scip, probdata) );
+   	}
+
+   	SCIP_CALL( createRows(scip, probdata) );
 
    	/* set user problem data */
    	SCIP_CALL( SCIPsetProbData(scip, probdata) );
 
-   	/* set pricer */
-   	// SCIP_CALL( SCIPpricerBinpackingActivate(scip, conss, weights, ids, nitems, capacity) );
+   	/* set pricer; in the aggregated formulation it prices one class vehicle per row */
+   	if (aggregated)
+   	{
+   		SCIP_CALL( SCIPpricerTP3SActivate(scip, probdata->testConss, probdata->vehicleConss, tests, classes, rehits, numTests, numClasses) );
+   	}
+   	else
+   	{
+   		SCIP_CALL( SCIPpricerTP3SActivate(scip, probdata->testConss, probdata->vehicleConss, tests, vehicles, rehits, numTests, numVehicles) );
+   	}
 
    	/* free local buffer arrays */
+   	SCIPfreeBufferArray(scip, &vehicleClass);
+   	SCIPfreeBufferArray(scip, &classSizes);
+   	SCIPfreeBufferArray(scip, &classes);
    	SCIPfreeBufferArray(scip, &testConss);
    	SCIPfreeBufferArray(scip, &vehicleConss);
 
@@ -461,19 +958,47 @@ SCIP_RETCODE SCIPprobdataCreate(
 
 }
 
-TEST* SCIPprobdataGetTests(
+SCIP_RETCODE SCIPprobdataCreate(
+	SCIP*			scip,
+	const char*		probname,
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
+	int 			numTests,
+	int 			numVehicles,
+	BITMATRIX*		rehits)
+{
+	SCIP_CALL( createProb(scip, probname, tests, vehicles, numTests, numVehicles, rehits, TRUE) );
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPprobdataCreateInPlace(
+	SCIP*			scip,
+	const char*		probname,
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
+	int 			numTests,
+	int 			numVehicles,
+	BITMATRIX*		rehits)
+{
+	SCIP_CALL( createProb(scip, probname, tests, vehicles, numTests, numVehicles, rehits, FALSE) );
+
+	return SCIP_OKAY;
+}
+
+const TEST* SCIPprobdataGetTests(
 	SCIP_PROBDATA*	probdata)
 {
 	return probdata->tests;
 }
 
-VEHICLE* SCIPprobdataGetVehicles(
+const VEHICLE* SCIPprobdataGetVehicles(
 	SCIP_PROBDATA* 	probdata)
 {
 	return probdata->vehicles;
 }
 
-int** SCIPprobdataGetRehitRules(
+BITMATRIX* SCIPprobdataGetRehitRules(
 	SCIP_PROBDATA* 	probdata)
 {
 	return probdata->rehits;
@@ -522,6 +1047,95 @@ SCIP_CONS** SCIPprobdataGetVehicleConss(
 	return probdata->vehicleConss;
 }
 
+int SCIPprobdataGetNumVehicleRows(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return numVehicleRows(probdata);
+}
+
+SCIP_Bool SCIPprobdataIsAggregated(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->aggregated;
+}
+
+int SCIPprobdataGetNumClasses(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->numClasses;
+}
+
+VEHICLE* SCIPprobdataGetClasses(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->classes;
+}
+
+int* SCIPprobdataGetClassSizes(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->classSizes;
+}
+
+int* SCIPprobdataGetVehicleClass(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->vehicleClass;
+}
+
+SCIP_Real SCIPprobdataGetSlackCost(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->slackCost;
+}
+
+int* SCIPprobdataGetTestColumns(
+	SCIP_PROBDATA*		probdata,
+	int					test
+	)
+{
+	assert(0 <= test && test < probdata->numTests);
+
+	return probdata->testCols[test];
+}
+
+int SCIPprobdataGetNTestColumns(
+	SCIP_PROBDATA*		probdata,
+	int					test
+	)
+{
+	assert(0 <= test && test < probdata->numTests);
+
+	return probdata->ntestCols[test];
+}
+
+int* SCIPprobdataGetVehicleColumns(
+	SCIP_PROBDATA*		probdata,
+	int					vehicle
+	)
+{
+	assert(0 <= vehicle && vehicle < numVehicleRows(probdata));
+
+	return probdata->vehicleCols[vehicle];
+}
+
+int SCIPprobdataGetNVehicleColumns(
+	SCIP_PROBDATA*		probdata,
+	int					vehicle
+	)
+{
+	assert(0 <= vehicle && vehicle < numVehicleRows(probdata));
+
+	return probdata->nvehicleCols[vehicle];
+}
+
 SCIP_RETCODE SCIPprobdataAddVar(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_PROBDATA*        probdata,           /**< problem data */
@@ -533,16 +1147,383 @@ SCIP_RETCODE SCIPprobdataAddVar(
    {
       probdata->varssize = MAX(100, probdata->varssize * 2);
       SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->vars, probdata->varssize) );
+      SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->ages, probdata->varssize) );
    }
 
    /* caputure variables */
    SCIP_CALL( SCIPcaptureVar(scip, var) );
 
    probdata->vars[probdata->nvars] = var;
+   probdata->ages[probdata->nvars] = 0;
+   SCIPvardataSetPos(SCIPvarGetData(var), probdata->nvars);
    probdata->nvars++;
 
+   SCIP_CALL( indexColumn(scip, probdata, probdata->nvars - 1) );
+
    SCIPdebugMessage("added variable to probdata; nvars = %d\n", probdata->nvars);
 
    return SCIP_OKAY;
 }
 
+
+
+/** creates the variable of a column record and adds it to the problem and to its rows; the pool adds deleted
+ *  columns again this way, with the record they had before. If newvar is not NULL, it receives the variable,
+ *  captured */
+static
+SCIP_RETCODE addColumnVar(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	SCIP_VARDATA*		vardata,
+	SCIP_Bool			priced,
+	SCIP_VAR**			newvar
+	)
+{
+	SCIP_VAR* var;
+	int* tests;
+	int ntests;
+	int vehicle;
+	char name[SCIP_MAXSTRLEN];
+
+	tests = SCIPvardataGetConsids(vardata);
+	ntests = SCIPvardataGetNConsids(vardata);
+	vehicle = SCIPvardataGetVehicleConsids(vardata);
+
+	/* without names SCIP numbers the columns; SCIPvardataGetName rebuilds the name when it is needed */
+	if (probdata->namedColumns)
+		SCIPvardataGetName(vardata, name, SCIP_MAXSTRLEN);
+
+	SCIP_CALL( SCIPcreateVarTP3S(scip, &var, probdata->namedColumns ? name : NULL, SCIPvardataGetCost(vardata),
+		!priced, TRUE, vardata) );
+
+	if (priced)
+	{
+		/* the added variable event stores the variable in the transformed problem data */
+		SCIP_CALL( SCIPaddPricedVar(scip, var, 1.0) );
+	}
+	else
+	{
+		SCIP_CALL( SCIPaddVar(scip, var) );
+
+		/* once the solve started, the added variable event stores it as well */
+		if (SCIPgetStage(scip) == SCIP_STAGE_PROBLEM)
+		{
+			SCIP_CALL( SCIPprobdataAddVar(scip, probdata, var) );
+		}
+	}
+
+	/* add variable to the covering constraints of its tests and the packing constraint of its vehicle; the columns
+	 * of the initial block enter the rows when these are created */
+	if (!probdata->pendingRows)
+	{
+		for (int k = 0; k < ntests; ++k)
+		{
+			SCIP_CALL( SCIPaddCoefSetppc(scip, probdata->testConss[tests[k]], var) );
+		}
+		if (probdata->aggregated)
+		{
+			SCIP_CALL( SCIPaddCoefLinear(scip, probdata->vehicleConss[vehicle], var, 1.0) );
+		}
+		else
+		{
+			SCIP_CALL( SCIPaddCoefSetppc(scip, probdata->vehicleConss[vehicle], var) );
+		}
+	}
+
+	/* change the upper bound of the binary variable to lazy since the upper bound is already enforced
+	 * due to the objective function the set covering constraint;
+	 * The reason for doing is that, is to avoid the bound of x <= 1 in the LP relaxation since this bound
+	 * constraint would produce a dual variable which might have a positive reduced cost
+	 */
+	SCIP_CALL( SCIPchgVarUbLazy(scip, var, 1.0) );
+
+	if (newvar != NULL)
+	{
+		SCIP_CALL( SCIPcaptureVar(scip, var) );
+		*newvar = var;
+	}
+
+	SCIP_CALL( SCIPreleaseVar(scip, &var) );
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPprobdataAddColumn(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	int					ntests,
+	int					vehicle,
+	SCIP_Real			cost,
+	SCIP_Bool			priced
+	)
+{
+	SCIP_VARDATA* vardata;
+
+	assert(probdata != NULL);
+	assert(ntests >= 1);
+	assert(0 <= vehicle && vehicle < numVehicleRows(probdata));
+
+	/* the variable data contains the information in which constraints the variable appears */
+	SCIP_CALL( SCIPvardataCreateTP3S(scip, &vardata, probdata->columns, tests, ntests, vehicle, cost) );
+
+	SCIP_CALL( addColumnVar(scip, probdata, vardata, priced, NULL) );
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPprobdataAddColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	const int*			testBeg,
+	const int*			vehicles,
+	const SCIP_Real*	costs,
+	int					ncols,
+	SCIP_Bool			priced
+	)
+{
+	int* ntests;
+	int* nrows;
+	int numRows;
+
+	assert(probdata != NULL);
+	assert(ncols >= 0);
+
+	if (ncols == 0)
+		return SCIP_OKAY;
+
+	numRows = numVehicleRows(probdata);
+
+	/* the variable array and the inverted indices grow once for the whole block */
+	if (probdata->varssize < probdata->nvars + ncols)
+	{
+		probdata->varssize = MAX(probdata->nvars + ncols, probdata->varssize * 2);
+		SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->vars, probdata->varssize) );
+		SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->ages, probdata->varssize) );
+	}
+
+	SCIP_CALL( SCIPallocClearBufferArray(scip, &ntests, probdata->numTests) );
+	SCIP_CALL( SCIPallocClearBufferArray(scip, &nrows, numRows) );
+
+	for (int c = 0; c < ncols; ++c)
+	{
+		for (int k = testBeg[c]; k < testBeg[c + 1]; ++k)
+			ntests[tests[k]]++;
+		nrows[vehicles[c]]++;
+	}
+
+	for (int t = 0; t < probdata->numTests; ++t)
+	{
+		if (ntests[t] > 0)
+		{
+			SCIP_CALL( reserveColumns(scip, &probdata->testCols[t], &probdata->testColsSize[t],
+				probdata->ntestCols[t] + ntests[t]) );
+		}
+	}
+	for (int v = 0; v < numRows; ++v)
+	{
+		if (nrows[v] > 0)
+		{
+			SCIP_CALL( reserveColumns(scip, &probdata->vehicleCols[v], &probdata->vehicleColsSize[v],
+				probdata->nvehicleCols[v] + nrows[v]) );
+		}
+	}
+
+	SCIPfreeBufferArray(scip, &nrows);
+	SCIPfreeBufferArray(scip, &ntests);
+
+	for (int c = 0; c < ncols; ++c)
+	{
+		SCIP_CALL( SCIPprobdataAddColumn(scip, probdata, tests + testBeg[c], testBeg[c + 1] - testBeg[c], vehicles[c],
+			costs[c], priced) );
+	}
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPprobdataAgeColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const SCIP_Real*	testDuals,
+	const SCIP_Real*	vehicleDuals,
+	int					maxage,
+	int*				ndeleted
+	)
+{
+	SCIP_SOL* bestsol;
+	int nretired;
+
+	assert(probdata != NULL);
+	assert(ndeleted != NULL);
+
+	*ndeleted = 0;
+	nretired = 0;
+	bestsol = SCIPgetBestSol(scip);
+
+	for (int i = 0; i < probdata->nvars; ++i)
+	{
+		SCIP_VAR* var = probdata->vars[i];
+		SCIP_VARDATA* vardata;
+		SCIP_Real redcost;
+		SCIP_Bool deleted;
+		int* consids;
+		int nconsids;
+
+		/* a column SCIP deleted on its own only needs its slot emptied */
+		if (SCIPvarIsDeleted(var))
+		{
+			SCIP_CALL( retireColumn(scip, probdata, i) );
+			nretired++;
+			continue;
+		}
+
+		if (SCIPvarGetStatus(var) == SCIP_VARSTATUS_COLUMN && SCIPcolIsInLP(SCIPvarGetCol(var)))
+		{
+			probdata->ages[i] = 0;
+			continue;
+		}
+
+		/* only columns the duals keep out of the LP grow old, those at zero reduced cost may come back any time */
+		vardata = SCIPvarGetData(var);
+		consids = SCIPvardataGetConsids(vardata);
+		nconsids = SCIPvardataGetNConsids(vardata);
+
+		redcost = SCIPvardataGetCost(vardata) - vehicleDuals[SCIPvardataGetVehicleConsids(vardata)];
+		for (int k = 0; k < nconsids; ++k)
+			redcost -= testDuals[consids[k]];
+
+		if (!SCIPisDualfeasPositive(scip, redcost))
+			continue;
+
+		if (++probdata->ages[i] <= maxage || maxage < 0)
+			continue;
+
+		/* a column that a branching decision ever fixed may have that fixing stored at an open node, and one whose
+		 * bounds differ at the current node has a bound change on the path; both stay, as do the columns of the
+		 * incumbent. The others are deleted from every node, so the pricer must be able to find them again */
+		if (!SCIPvarIsDeletable(var) || SCIPvardataGetNFixings(vardata) > 0 || SCIPvarGetLbGlobal(var) > 0.5
+			|| SCIPvarGetLbLocal(var) != SCIPvarGetLbGlobal(var) || SCIPvarGetUbLocal(var) != SCIPvarGetUbGlobal(var)
+			|| (bestsol != NULL && SCIPgetSolVal(scip, bestsol, var) > 0.5))
+			continue;
+
+		SCIP_CALL( SCIPdelVar(scip, var, &deleted) );
+
+		if (deleted)
+		{
+			SCIP_CALL( retireColumn(scip, probdata, i) );
+			nretired++;
+			(*ndeleted)++;
+		}
+	}
+
+	/* the variable array keeps no slots of deleted columns beyond this round */
+	if (nretired > 0)
+	{
+		SCIP_CALL( compactColumns(scip, probdata) );
+	}
+
+	return SCIP_OKAY;
+}
+
+SCIP_VARDATA** SCIPprobdataGetPoolColumns(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->pool;
+}
+
+int SCIPprobdataGetNPoolColumns(
+	SCIP_PROBDATA*		probdata
+	)
+{
+	return probdata->npool;
+}
+
+SCIP_RETCODE SCIPprobdataRestoreColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			idx,
+	int					nidx
+	)
+{
+	int npool;
+	int k;
+
+	assert(probdata != NULL);
+	assert(nidx >= 0);
+
+	if (nidx == 0)
+		return SCIP_OKAY;
+
+	if (probdata->varssize < probdata->nvars + nidx)
+	{
+		probdata->varssize = MAX(probdata->nvars + nidx, probdata->varssize * 2);
+		SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->vars, probdata->varssize) );
+		SCIP_CALL( SCIPreallocMemoryArray(scip, &probdata->ages, probdata->varssize) );
+	}
+
+	for (k = 0; k < nidx; ++k)
+	{
+		assert(0 <= idx[k] && idx[k] < probdata->npool);
+		assert(k == 0 || idx[k - 1] < idx[k]);
+		assert(SCIPvardataGetPos(probdata->pool[idx[k]]) == -1);
+
+		SCIP_CALL( addColumnVar(scip, probdata, probdata->pool[idx[k]], TRUE, NULL) );
+	}
+
+	/* the remaining columns keep their order, oldest first */
+	npool = 0;
+	k = 0;
+	for (int i = 0; i < probdata->npool; ++i)
+	{
+		if (k < nidx && idx[k] == i)
+			++k;
+		else
+			probdata->pool[npool++] = probdata->pool[i];
+	}
+	probdata->npool = npool;
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPprobdataGetSolColumn(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	int					ntests,
+	int					vehicle,
+	SCIP_Real			cost,
+	SCIP_VAR**			var
+	)
+{
+	SCIP_VARDATA* vardata;
+	int* cols;
+	int ncols;
+
+	assert(probdata != NULL);
+	assert(ntests >= 1);
+	assert(0 <= vehicle && vehicle < numVehicleRows(probdata));
+	assert(var != NULL);
+
+	/* a column with the same sequence on the row is used instead of a copy */
+	cols = probdata->vehicleCols[vehicle];
+	ncols = probdata->nvehicleCols[vehicle];
+	for (int i = 0; i < ncols; ++i)
+	{
+		vardata = SCIPvarGetData(probdata->vars[cols[i]]);
+
+		if (SCIPvardataGetNConsids(vardata) == ntests
+			&& memcmp(SCIPvardataGetSequence(vardata), tests, (size_t) ntests * sizeof(int)) == 0)
+		{
+			*var = probdata->vars[cols[i]];
+			SCIP_CALL( SCIPcaptureVar(scip, *var) );
+			return SCIP_OKAY;
+		}
+	}
+
+	SCIP_CALL( SCIPvardataCreateTP3S(scip, &vardata, probdata->columns, tests, ntests, vehicle, cost) );
+	SCIP_CALL( addColumnVar(scip, probdata, vardata, FALSE, var) );
+
+	return SCIP_OKAY;
+}
@@ -4,27 +4,42 @@
 #include "scip/scip.h"
 #include "vardata_tp3s.h"
 #include "data_structure.h"
+#include "bitmatrix.h"
 
+/** creates the problem; tests and vehicles are copied, the rehit matrix is captured */
 extern 
 SCIP_RETCODE SCIPprobdataCreate(
 	SCIP*			scip,
 	const char*		probname,
-	TEST*			tests,
-	VEHICLE*		vehicles,
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
 	int 			numTests,
 	int 			numVehicles,
-	int**			rehits);
+	BITMATRIX*		rehits);
 
+/** creates the problem like SCIPprobdataCreate, but uses the test and vehicle arrays in place;
+ *  they must stay valid until the problem is freed */
 extern 
-TEST* SCIPprobdataGetTests(
+SCIP_RETCODE SCIPprobdataCreateInPlace(
+	SCIP*			scip,
+	const char*		probname,
+	const TEST*		tests,
+	const VEHICLE*	vehicles,
+	int 			numTests,
+	int 			numVehicles,
+	BITMATRIX*		rehits);
+
+extern 
+const TEST* SCIPprobdataGetTests(
 	SCIP_PROBDATA*	probdata);
 
 extern
-VEHICLE* SCIPprobdataGetVehicles(
+const VEHICLE* SCIPprobdataGetVehicles(
 	SCIP_PROBDATA* 	probdata);
 
+/** returns the rehit rules, row i holds the tests that may follow test i */
 extern
-int** SCIPprobdataGetRehitRules(
+BITMATRIX* SCIPprobdataGetRehitRules(
 	SCIP_PROBDATA* 	probdata);
 
 extern
@@ -35,7 +50,8 @@ extern
 int SCIPprobdataGetNumVehicles(
 	SCIP_PROBDATA* 	probdata);
 
-/** returns array of all variables ordered in the way they got generated */
+/** returns array of all variables ordered in the way they got generated; deleting columns moves the later ones
+ *  forward */
 extern
 SCIP_VAR** SCIPprobdataGetVars(
    	SCIP_PROBDATA*        probdata            /**< problem data */
@@ -53,11 +69,84 @@ SCIP_CONS** SCIPprobdataGetTestConss(
    	SCIP_PROBDATA*        probdata            /**< problem data */
    );
 
+/** returns the vehicle rows: a set packing row per vehicle, or a capacity row per vehicle class in the
+ *  aggregated formulation */
 extern
 SCIP_CONS** SCIPprobdataGetVehicleConss(
 	SCIP_PROBDATA*		probdata
 	);
 
+/** returns the number of vehicle rows */
+extern
+int SCIPprobdataGetNumVehicleRows(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** is there one capacity row per vehicle class instead of one row per vehicle? columns are then assigned to
+ *  a class instead of a vehicle */
+extern
+SCIP_Bool SCIPprobdataIsAggregated(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the number of vehicle classes, vehicles of a class have the same release */
+extern
+int SCIPprobdataGetNumClasses(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns one vehicle per class, the first vehicle of the class */
+extern
+VEHICLE* SCIPprobdataGetClasses(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the number of vehicles of each class */
+extern
+int* SCIPprobdataGetClassSizes(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the class of each vehicle */
+extern
+int* SCIPprobdataGetVehicleClass(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the cost of the slack column every test has in lazy mode, infinity if there are no slack columns; the
+ *  slack columns have no variable data and are not among the variables of the problem data */
+extern
+SCIP_Real SCIPprobdataGetSlackCost(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the positions in the variable array of the columns serving the test, in increasing order */
+extern
+int* SCIPprobdataGetTestColumns(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   test                /**< test index */
+   );
+
+/** returns the number of columns serving the test */
+extern
+int SCIPprobdataGetNTestColumns(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   test                /**< test index */
+   );
+
+/** returns the positions in the variable array of the columns of the vehicle row, in increasing order */
+extern
+int* SCIPprobdataGetVehicleColumns(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   vehicle             /**< vehicle row index */
+   );
+
+/** returns the number of columns of the vehicle row */
+extern
+int SCIPprobdataGetNVehicleColumns(
+   SCIP_PROBDATA*        probdata,           /**< problem data */
+   int                   vehicle             /**< vehicle row index */
+   );
 
 /** adds given variable to the problem data */
 extern
@@ -67,5 +156,83 @@ SCIP_RETCODE SCIPprobdataAddVar(
    SCIP_VAR*             var                 /**< variables to add */
    );
 
+/** creates the column that serves tests[0..ntests-1] in this order on the given vehicle row and adds it to the
+ *  problem; priced columns are added during pricing, the others to the original problem */
+extern
+SCIP_RETCODE SCIPprobdataAddColumn(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	int					ntests,
+	int					vehicle,
+	SCIP_Real			cost,
+	SCIP_Bool			priced
+	);
+
+/** adds a block of columns like SCIPprobdataAddColumn: column c serves tests[testBeg[c]..testBeg[c+1]-1] in this
+ *  order on vehicle row vehicles[c] at cost costs[c]. The variable array and the inverted indices are sized for the
+ *  whole block before the first column is added. The initial block of the problem enters the rows when they are
+ *  created, with all their columns in one call; later blocks are added to the rows coefficient by coefficient */
+extern
+SCIP_RETCODE SCIPprobdataAddColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	const int*			testBeg,
+	const int*			vehicles,
+	const SCIP_Real*	costs,
+	int					ncols,
+	SCIP_Bool			priced
+	);
+
+/** ages the columns that are out of the LP by one pricing round if the duals give them a positive reduced cost, and
+ *  deletes those older than maxage (-1: never) from the problem; deleted columns move to the column pool and the
+ *  variable array is compacted, which marks all branching constraints as unpropagated. Columns that a branching
+ *  decision ever fixed, columns with local bound changes and columns in the incumbent are kept */
+extern
+SCIP_RETCODE SCIPprobdataAgeColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const SCIP_Real*	testDuals,			/**< dual of each test row */
+	const SCIP_Real*	vehicleDuals,		/**< dual of each vehicle row */
+	int					maxage,
+	int*				ndeleted			/**< pointer to store the number of deleted columns */
+	);
+
+/** returns the data of the deleted columns in the pool, oldest first */
+extern
+SCIP_VARDATA** SCIPprobdataGetPoolColumns(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** returns the number of deleted columns in the pool */
+extern
+int SCIPprobdataGetNPoolColumns(
+	SCIP_PROBDATA*		probdata
+	);
+
+/** adds the pool columns at the given increasing pool positions to the problem as priced columns and removes them
+ *  from the pool */
+extern
+SCIP_RETCODE SCIPprobdataRestoreColumns(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			idx,
+	int					nidx
+	);
+
+/** returns the variable of the column that serves tests[0..ntests-1] in this order on the given vehicle row,
+ *  captured; the column is added to the problem if it is not there. Primal heuristics use it to build solutions
+ *  during the solve */
+extern
+SCIP_RETCODE SCIPprobdataGetSolColumn(
+	SCIP*				scip,
+	SCIP_PROBDATA*		probdata,
+	const int*			tests,
+	int					ntests,
+	int					vehicle,
+	SCIP_Real			cost,
+	SCIP_VAR**			var
+	);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include <assert.h>
+#include <string.h>
+
+#include "prop_decisions.h"
+#include "cons_samediff.h"
+#include "cons_testonvehicle.h"
+#include "cons_testorderonvehicle.h"
+#include "probdata_tp3s.h"
+#include "vardata_tp3s.h"
+#include "bitmatrix.h"
+
+#define PROP_NAME              "decisions"
+#define PROP_DESC              "fixes the new columns violating any branching decision of the node in one pass"
+#define PROP_PRIORITY          1000000  /**< runs before the constraint handlers, which then find nothing left to do */
+#define PROP_FREQ              1
+#define PROP_DELAY             FALSE
+#define PROP_TIMING            SCIP_PROPTIMING_BEFORELP
+
+/** a same/differ or test order decision that is checked test by test */
+struct PairDecision
+{
+   int                   tid1;               /**< first test */
+   int                   tid2;               /**< second test */
+   int                   vid;                /**< vehicle row of an order decision, -1 for same/differ */
+   SCIP_Bool             together;           /**< SAME or ENFORCE? */
+};
+typedef struct PairDecision PAIRDECISION;
+
+/** all unpropagated decisions of the node; test on vehicle decisions become a mask of forbidden tests per vehicle
+ *  row, the others are only looked at for columns serving one of their tests */
+struct DecisionFilter
+{
+   int                   nwords;             /**< words per test bitset */
+   int                   nrows;              /**< number of vehicle rows */
+   uint64_t*             forbidden;          /**< per vehicle row the tests its columns must not serve */
+   uint64_t*             pairtests;          /**< tests of the pair decisions */
+   PAIRDECISION*         pairs;              /**< pair decisions */
+   int                   npairs;
+   SCIP_Bool             hasforbidden;       /**< is any test forbidden on some vehicle row? */
+};
+typedef struct DecisionFilter DECISIONFILTER;
+
+/** adds a test on vehicle decision to the filter */
+static
+void addTestOnVehicle(
+   DECISIONFILTER*       filter,             /**< decision filter */
+   int                   tid,                /**< test */
+   int                   vid,                /**< vehicle row */
+   CONSTYPE              type                /**< ENFORCE or FORBID */
+   )
+{
+   if( type == FORBID )
+      bitset_set(filter->forbidden + (size_t) vid * filter->nwords, tid);
+   else
+   {
+      for( int v = 0; v < filter->nrows; ++v )
+      {
+         if( v != vid )
+            bitset_set(filter->forbidden + (size_t) v * filter->nwords, tid);
+      }
+   }
+
+   filter->hasforbidden = TRUE;
+}
+
+/** adds a same/differ or test order decision to the filter */
+static
+void addPair(
+   DECISIONFILTER*       filter,             /**< decision filter */
+   int                   tid1,               /**< first test */
+   int                   tid2,               /**< second test */
+   int                   vid,                /**< vehicle row of an order decision, -1 for same/differ */
+   SCIP_Bool             together            /**< SAME or ENFORCE? */
+   )
+{
+   PAIRDECISION* pair = &filter->pairs[filter->npairs++];
+
+   pair->tid1 = tid1;
+   pair->tid2 = tid2;
+   pair->vid = vid;
+   pair->together = together;
+
+   bitset_set(filter->pairtests, tid1);
+   bitset_set(filter->pairtests, tid2);
+}
+
+/** returns whether a column violates a pair decision */
+static
+SCIP_Bool violatesPair(
+   const PAIRDECISION*   pair,               /**< pair decision */
+   SCIP_VARDATA*         vardata,            /**< variable data of the column */
+   const uint64_t*       signature           /**< tests of the column */
+   )
+{
+   int* sequence;
+   int existid1;
+   int existid2;
+   int i;
+
+   existid1 = bitset_get(signature, pair->tid1);
+   existid2 = bitset_get(signature, pair->tid2);
+
+   /* SAME and ENFORCE want both tests or neither */
+   if( existid1 != existid2 )
+      return pair->together;
+
+   if( !existid1 )
+      return FALSE;
+
+   /* DIFFER forbids both tests in one column */
+   if( pair->vid < 0 )
+      return !pair->together;
+
+   if( SCIPvardataGetVehicleConsids(vardata) != pair->vid )
+      return pair->together;
+
+   /* both tests on the vehicle of an order decision */
+   sequence = SCIPvardataGetSequence(vardata);
+   for( i = 0; sequence[i] != pair->tid1 && sequence[i] != pair->tid2; ++i )
+      ;
+
+   return (sequence[i] == pair->tid1) != pair->together;
+}
+
+/** returns whether a column violates any decision of the filter */
+static
+SCIP_Bool violatesFilter(
+   const DECISIONFILTER* filter,             /**< decision filter */
+   SCIP_VARDATA*         vardata             /**< variable data of the column */
+   )
+{
+   const uint64_t* signature;
+   int w;
+
+   signature = SCIPvardataGetSignature(vardata);
+
+   if( filter->hasforbidden )
+   {
+      const uint64_t* forbidden = filter->forbidden + (size_t) SCIPvardataGetVehicleConsids(vardata) * filter->nwords;
+
+      if( bitset_and_popcount(signature, forbidden, filter->nwords) > 0 )
+         return TRUE;
+   }
+
+   for( w = 0; w < filter->nwords && (signature[w] & filter->pairtests[w]) == 0; ++w )
+      ;
+
+   if( w == filter->nwords )
+      return FALSE;
+
+   for( int p = 0; p < filter->npairs; ++p )
+   {
+      if( violatesPair(&filter->pairs[p], vardata, signature) )
+         return TRUE;
+   }
+
+   return FALSE;
+}
+
+/** collects the unpropagated active constraints of a handler; returns the first column they still have to check */
+static
+void collectConss(
+   SCIP_CONSHDLR*        conshdlr,           /**< constraint handler, or NULL if not included */
+   SCIP_Bool             (*ispropagated)(SCIP*, SCIP_CONS*),
+   int                   (*getnpropagatedvars)(SCIP*, SCIP_CONS*),
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_CONS**           conss,              /**< array to append the constraints to */
+   int*                  nconss,             /**< number of constraints in the array */
+   int*                  firstvar            /**< first column to check, lowered if needed */
+   )
+{
+   SCIP_CONS** active;
+   int nactive;
+
+   if( conshdlr == NULL )
+      return;
+
+   active = SCIPconshdlrGetConss(conshdlr);
+   nactive = SCIPconshdlrGetNActiveConss(conshdlr);
+
+   for( int c = 0; c < nactive; ++c )
+   {
+      if( ispropagated(scip, active[c]) )
+         continue;
+
+      conss[(*nconss)++] = active[c];
+      *firstvar = MIN(*firstvar, getnpropagatedvars(scip, active[c]));
+   }
+}
+
+/** execution method of propagator */
+static
+SCIP_DECL_PROPEXEC(propExecDecisions)
+{  /*lint --e{715}*/
+   SCIP_PROBDATA* probdata;
+   SCIP_CONSHDLR* samediffhdlr;
+   SCIP_CONSHDLR* testonvehiclehdlr;
+   SCIP_CONSHDLR* testorderhdlr;
+   SCIP_CONS** conss;
+   SCIP_VAR** vars;
+   DECISIONFILTER filter;
+   int nsamediff;
+   int ntestonvehicle;
+   int nconss;
+   int maxconss;
+   int firstvar;
+   int nvars;
+   int nfixedvars;
+   SCIP_Bool cutoff;
+
+   assert(scip != NULL);
+   assert(strcmp(SCIPpropGetName(prop), PROP_NAME) == 0);
+   assert(result != NULL);
+
+   *result = SCIP_DIDNOTRUN;
+
+   probdata = SCIPgetProbData(scip);
+   if( probdata == NULL )
+      return SCIP_OKAY;
+
+   samediffhdlr = SCIPfindConshdlr(scip, "samediff");
+   testonvehiclehdlr = SCIPfindConshdlr(scip, "testonvehicle");
+   testorderhdlr = SCIPfindConshdlr(scip, "testorderonvehicle");
+
+   maxconss = (samediffhdlr != NULL ? SCIPconshdlrGetNActiveConss(samediffhdlr) : 0)
+      + (testonvehiclehdlr != NULL ? SCIPconshdlrGetNActiveConss(testonvehiclehdlr) : 0)
+      + (testorderhdlr != NULL ? SCIPconshdlrGetNActiveConss(testorderhdlr) : 0);
+
+   if( maxconss == 0 )
+      return SCIP_OKAY;
+
+   vars = SCIPprobdataGetVars(probdata);
+   nvars = SCIPprobdataGetNVars(probdata);
+
+   SCIP_CALL( SCIPallocBufferArray(scip, &conss, maxconss) );
+
+   nconss = 0;
+   firstvar = nvars;
+   collectConss(samediffhdlr, SCIPisPropagatedSamediff, SCIPgetNPropagatedVarsSamediff, scip,
+      conss, &nconss, &firstvar);
+   nsamediff = nconss;
+   collectConss(testonvehiclehdlr, SCIPisPropagatedTestOnVehicle, SCIPgetNPropagatedVarsTestOnVehicle, scip,
+      conss, &nconss, &firstvar);
+   ntestonvehicle = nconss - nsamediff;
+   collectConss(testorderhdlr, SCIPisPropagatedTestOrderOnVehicle, SCIPgetNPropagatedVarsTestOrderOnVehicle, scip,
+      conss, &nconss, &firstvar);
+
+   if( nconss == 0 )
+   {
+      SCIPfreeBufferArray(scip, &conss);
+      return SCIP_OKAY;
+   }
+
+   *result = SCIP_DIDNOTFIND;
+
+   /* build the filter */
+   filter.nwords = bitset_nwords(SCIPprobdataGetNumTests(probdata));
+   filter.nrows = SCIPprobdataGetNumVehicleRows(probdata);
+   filter.npairs = 0;
+   filter.hasforbidden = FALSE;
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &filter.forbidden, filter.nrows * filter.nwords) );
+   SCIP_CALL( SCIPallocClearBufferArray(scip, &filter.pairtests, filter.nwords) );
+   SCIP_CALL( SCIPallocBufferArray(scip, &filter.pairs, nconss) );
+
+   for( int c = 0; c < nconss; ++c )
+   {
+      if( c < nsamediff )
+         addPair(&filter, SCIPgetTid1Samediff(scip, conss[c]), SCIPgetTid2Samediff(scip, conss[c]), -1,
+            SCIPgetTypeSamediff(scip, conss[c]) == SAME);
+      else if( c < nsamediff + ntestonvehicle )
+         addTestOnVehicle(&filter, SCIPgetTidTestOnVehicle(scip, conss[c]), SCIPgetVidTestOnVehicle(scip, conss[c]),
+            SCIPgetTypeTestOnVehicle(scip, conss[c]));
+      else
+         addPair(&filter, SCIPgetTid1TestOrderOnVehicle(scip, conss[c]), SCIPgetTid2TestOrderOnVehicle(scip, conss[c]),
+            SCIPgetVidTestOrderOnVehicle(scip, conss[c]), SCIPgetTypeTestOrderOnVehicle(scip, conss[c]) == ENFORCE);
+   }
+
+   SCIPdebugMessage("check columns %d to %d against %d decisions\n", firstvar, nvars, nconss);
+
+   /* one pass over the new columns */
+   nfixedvars = 0;
+   cutoff = FALSE;
+
+   for( int v = firstvar; v < nvars && !cutoff; ++v )
+   {
+      if( SCIPvarGetUbLocal(vars[v]) < 0.5 || !violatesFilter(&filter, SCIPvarGetData(vars[v])) )
+         continue;
+
+      SCIP_CALL( SCIPfixVarTP3S(scip, vars[v], &cutoff, &nfixedvars) );
+   }
+
+   SCIPdebugMessage("fixed %d variables locally\n", nfixedvars);
+
+   /* the constraint handlers skip propagated constraints */
+   if( cutoff )
+      *result = SCIP_CUTOFF;
+   else
+   {
+      for( int c = 0; c < nconss; ++c )
+      {
+         if( c < nsamediff )
+            SCIPmarkPropagatedSamediff(scip, conss[c], nvars);
+         else if( c < nsamediff + ntestonvehicle )
+            SCIPmarkPropagatedTestOnVehicle(scip, conss[c], nvars);
+         else
+            SCIPmarkPropagatedTestOrderOnVehicle(scip, conss[c], nvars);
+      }
+
+      if( nfixedvars > 0 )
+         *result = SCIP_REDUCEDDOM;
+   }
+
+   SCIPfreeBufferArray(scip, &filter.pairs);
+   SCIPfreeBufferArray(scip, &filter.pairtests);
+   SCIPfreeBufferArray(scip, &filter.forbidden);
+   SCIPfreeBufferArray(scip, &conss);
+
+   return SCIP_OKAY;
+}
+
+/** creates the decisions propagator and includes it in SCIP */
+SCIP_RETCODE SCIPincludePropDecisions(
+   SCIP*                 scip                /**< SCIP data structure */
+   )
+{
+   SCIP_PROP* prop;
+
+   prop = NULL;
+
+   SCIP_CALL( SCIPincludePropBasic(scip, &prop, PROP_NAME, PROP_DESC, PROP_PRIORITY, PROP_FREQ, PROP_DELAY,
+         PROP_TIMING, propExecDecisions, NULL) );
+   assert(prop != NULL);
+
+   return SCIP_OKAY;
+}
@@ -0,0 +1,13 @@
+#ifndef _SCIP_PROP_DECISIONS_H_
+#define _SCIP_PROP_DECISIONS_H_
+
+#include "scip/scip.h"
+
+/** creates the propagator that checks the new columns against all branching decisions of a node in one pass and
+ *  includes it in SCIP */
+extern
+SCIP_RETCODE SCIPincludePropDecisions(
+   SCIP*                 scip                /**< SCIP data structure */
+   );
+
+#endif
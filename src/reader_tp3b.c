@@ -0,0 +1,106 @@
+#include <assert.h>
+#include <stdlib.h>
+
+#include "reader_tp3b.h"
+
+#include "tp3b_format.h"
+#include "data_structure.h"
+#include "probdata_tp3s.h"
+
+#define READER_NAME			"tp3breader"
+#define READER_DESC			"file reader for binary tp3s problems"
+#define READER_EXTENSION	"tp3b"
+
+/** the mapping of the last read file; the problem uses its arrays in place */
+struct SCIP_ReaderData
+{
+	TP3BMAP				map;
+};
+
+
+/** destructor of reader to free user data (called when SCIP is exiting) */
+static
+SCIP_DECL_READERFREE(readerFreeTP3B)
+{
+	SCIP_READERDATA* readerdata;
+
+	readerdata = SCIPreaderGetData(reader);
+	assert(readerdata != NULL);
+
+	/* SCIPfree() frees the problem before the plugins, so nothing refers to the mapping anymore */
+	unmap_tp3b(&readerdata->map);
+	SCIPfreeMemory(scip, &readerdata);
+
+	return SCIP_OKAY;
+}
+
+static 
+SCIP_DECL_READERREAD(readerReadTP3B)
+{
+	SCIP_READERDATA* readerdata;
+	TP3BMAP map;
+	BITMATRIX* rehits;
+	SCIP_RETCODE retcode;
+
+	*result = SCIP_DIDNOTRUN;
+
+	readerdata = SCIPreaderGetData(reader);
+	assert(readerdata != NULL);
+
+	printf("data file path %s\n", filename);
+
+	if (map_tp3b(filename, &map) != 0)
+	{
+		SCIPerrorMessage("cannot read tp3b file <%s>\n", filename);
+		return SCIP_READERROR;
+	}
+
+	printf("num tests: %d, num vehicles: %d\n", map.numTests, map.numVehicles);
+
+	/* the rehit bitset of the file is the word layout of the matrix, no copy needed */
+	rehits = bitmatrix_wrap(map.rehits, map.numTests, map.numTests);
+	if (rehits == NULL)
+	{
+		unmap_tp3b(&map);
+		return SCIP_NOMEMORY;
+	}
+
+	/* creating the problem frees the previous one, only then its mapping can go */
+	retcode = SCIPprobdataCreateInPlace(scip, filename, map.tests, map.vehicles,
+		map.numTests, map.numVehicles, rehits);
+	if (retcode != SCIP_OKAY)
+	{
+		bitmatrix_release(&rehits);
+		unmap_tp3b(&map);
+		return retcode;
+	}
+
+	unmap_tp3b(&readerdata->map);
+	readerdata->map = map;
+
+	/* the problem data holds its own reference */
+	bitmatrix_release(&rehits);
+
+	*result = SCIP_SUCCESS;
+
+	return SCIP_OKAY;
+}
+
+SCIP_RETCODE SCIPincludeReaderTP3B(
+	SCIP*				scip)
+{
+	SCIP_READERDATA* readerData;
+	SCIP_READER* reader;
+
+	SCIP_CALL( SCIPallocMemory(scip, &readerData) );
+	readerData->map.base = NULL;
+
+	SCIP_CALL( SCIPincludeReaderBasic(scip, &reader, READER_NAME,
+		READER_DESC, READER_EXTENSION, readerData));
+	assert(reader != NULL);
+
+	SCIP_CALL( SCIPsetReaderRead(scip, reader, readerReadTP3B));
+	SCIP_CALL( SCIPsetReaderFree(scip, reader, readerFreeTP3B));
+
+	return SCIP_OKAY;
+}
@@ -0,0 +1,13 @@
+#ifndef _SCIP_READER_TP3B_H_
+#define _SCIP_READER_TP3B_H_
+
+#include "scip/scip.h"
+
+/** includes the reader for binary tp3b instance files */
+extern
+SCIP_RETCODE SCIPincludeReaderTP3B(
+	SCIP*			scip
+	);
+
+
+#endif
@@ -1,65 +1,97 @@
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <scip/cons_setppc.h>
 
 #include "reader_tp3s.h"
 
 #include "json_read.h"
+#include "json_stream.h"
+#include "tp3b_format.h"
 #include "data_structure.h"
-#include "reader_tp3s.h"
+#include "probdata_tp3s.h"
 
 #define READER_NAME			"tp3sreader"
 #define READER_DESC			"file reader for tp3s problems"
 #define READER_EXTENSION	"tp3s"
 
+#define DEFAULT_STREAMING	TRUE	/**< read with the streaming tokenizer instead of building the json tree */
+#define DEFAULT_WRITEBINARY	FALSE	/**< convert each read file to a .tp3b file next to it */
+
+
+/** writes the instance as <name>.tp3b next to the .tp3s file */
+static
+SCIP_RETCODE writeBinaryCopy(
+	SCIP*			scip,
+	const char*		filename,
+	INSTANCE*		inst
+	)
+{
+	char binname[SCIP_MAXSTRLEN];
+	char* extension;
+
+	(void) SCIPsnprintf(binname, SCIP_MAXSTRLEN - 5, "%s", filename);
+
+	extension = strrchr(binname, '.');
+	if (extension != NULL && strcmp(extension, "."READER_EXTENSION) == 0)
+		*extension = '\0';
+	strcat(binname, ".tp3b");
+
+	if (write_tp3b(binname, inst) != 0)
+	{
+		SCIPwarningMessage(scip, "could not write binary instance <%s>\n", binname);
+	}
+	else
+		printf("wrote binary instance %s\n", binname);
+
+	return SCIP_OKAY;
+}
+
 
 static 
 SCIP_DECL_READERREAD(readerReadTP3S)
 {
-	int numTests;
-	int numVehicles;
-
-	/* buffers */
-	TEST* tests;
-	VEHICLE* vehicles;
-	int** rehits;
+	INSTANCE inst;
+	LOADTIMES times;
+	SCIP_Bool streaming;
+	SCIP_Bool writebinary;
+	int retcode;
 
 	*result = SCIP_DIDNOTRUN;
 
 	printf("data file path %s\n", filename);
 
-	numTests = get_tests_size(filename);
-	numVehicles = get_vehicle_size(filename);
+	SCIP_CALL( SCIPgetBoolParam(scip, "reading/"READER_NAME"/streaming", &streaming) );
 
-	printf("num tests: %d, num vehicles: %d\n", numTests, numVehicles);
+	/* parse the file once, this fills tests, vehicles and rehit rules */
+	if (streaming)
+		retcode = read_in_instance_stream(filename, &inst, &times);
+	else
+		retcode = read_in_instance(filename, &inst, &times);
 
-	/* allocate memory */
-	SCIP_CALL( SCIPallocBufferArray(scip, &tests, numTests));
-	SCIP_CALL( SCIPallocBufferArray(scip, &vehicles, numVehicles));
-	SCIP_CALL( SCIPallocBufferArray(scip, &rehits, numTests));
-	for (int i = 0; i < numTests; ++i)
+	if (retcode != 0)
 	{
-		SCIP_CALL( SCIPallocBufferArray(scip, &rehits[i], numTests));
+		SCIPerrorMessage("cannot read tp3s file <%s>\n", filename);
+		return SCIP_READERROR;
 	}
 
+	printf("num tests: %d, num vehicles: %d\n", inst.numTests, inst.numVehicles);
+	printf("load time: parse %.3fs, tests %.3fs, vehicles %.3fs, rehits %.3fs\n",
+		times.parse, times.tests, times.vehicles, times.rehits);
 
-	read_in_tests(filename, tests);
-	read_in_vehicles(filename, vehicles);
-	read_in_rehit_rules(filename, rehits);
-	
-	
-	SCIPfreeBufferArray(scip, &tests);
-	SCIPfreeBufferArray(scip, &vehicles);
-	for (int i = 0; i < numTests; ++i)
+	SCIP_CALL( SCIPgetBoolParam(scip, "reading/"READER_NAME"/writebinary", &writebinary) );
+	if (writebinary)
 	{
-		SCIPfreeBufferArray(scip, &rehits[i]);
+		SCIP_CALL( writeBinaryCopy(scip, filename, &inst) );
 	}
-	SCIPfreeBufferArray(scip, &rehits);
 
-	*result = SCIP_SUCCESS;
+	SCIP_CALL( SCIPprobdataCreate(scip, filename, inst.tests, inst.vehicles,
+		inst.numTests, inst.numVehicles, inst.rehits) );
 
+	free_instance(&inst);
 
+	*result = SCIP_SUCCESS;
 
 	return SCIP_OKAY;
 }
@@ -78,5 +110,12 @@ SCIP_RETCODE SCIPincludeReaderTP3S(
 
 	SCIP_CALL( SCIPsetReaderRead(scip, reader, readerReadTP3S));
 
+	SCIP_CALL( SCIPaddBoolParam(scip, "reading/"READER_NAME"/streaming",
+		"should the file be read by the streaming tokenizer instead of building the json tree first?",
+		NULL, FALSE, DEFAULT_STREAMING, NULL, NULL) );
+	SCIP_CALL( SCIPaddBoolParam(scip, "reading/"READER_NAME"/writebinary",
+		"should each read file be converted to a binary .tp3b file next to it?",
+		NULL, FALSE, DEFAULT_WRITEBINARY, NULL, NULL) );
+
 	return SCIP_OKAY;
 }
\ No newline at end of file
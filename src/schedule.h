@@ -0,0 +1,42 @@
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include "data_structure.h"
+
+#define SINGLE_TEST_COST	50		/* extra cost of a column that serves a single test */
+
+/* completion time of test on a vehicle that becomes free at time avail */
+static inline
+int test_completion(const TEST* test, int avail)
+{
+	int start = avail > (int) test->release ? avail : (int) test->release;
+
+	return start + (int) test->dur;
+}
+
+/* tardiness of test completed at the given time */
+static inline
+int test_tardiness(const TEST* test, int completion)
+{
+	return completion > (int) test->deadline ? completion - (int) test->deadline : 0;
+}
+
+/* cost of serving seq[0..n-1] in this order on a vehicle released at time
+ * release: the total tardiness, plus SINGLE_TEST_COST for single test columns */
+static inline
+int sequence_cost(const TEST* tests, const int* seq, int n, int release)
+{
+	int time = release;
+	int cost = (n == 1) ? SINGLE_TEST_COST : 0;
+	int k;
+
+	for (k = 0; k < n; ++k)
+	{
+		time = test_completion(&tests[seq[k]], time);
+		cost += test_tardiness(&tests[seq[k]], time);
+	}
+
+	return cost;
+}
+
+#endif
@@ -0,0 +1,183 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "thread_pool.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct thread_pool
+{
+	pthread_t*		threads;
+	int				nworkers;
+
+	pthread_mutex_t	lock;
+	pthread_cond_t	wakeup;			/* signals a new batch or shutdown */
+	pthread_cond_t	finished;		/* signals the end of a batch */
+
+	/* the current batch, guarded by lock */
+	POOLTASK		task;
+	void*			arg;
+	int				ntasks;
+	int				next;			/* next task to hand out */
+	int				ndone;
+	long			batch;			/* number of the current batch */
+	int				shutdown;
+};
+
+// function prototypes
+static void* worker_main(void *data);
+static void run_tasks(THREADPOOL *pool);
+
+THREADPOOL* threadpool_create(int nthreads)
+{
+	THREADPOOL *pool;
+	int i;
+
+	assert(nthreads >= 1);
+
+	pool = (THREADPOOL*) calloc(1, sizeof(THREADPOOL));
+	if (pool == NULL)
+		return NULL;
+
+	pool->threads = (pthread_t*) malloc((nthreads > 1 ? nthreads - 1 : 1) * sizeof(pthread_t));
+	if (pool->threads == NULL)
+	{
+		free(pool);
+		return NULL;
+	}
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wakeup, NULL);
+	pthread_cond_init(&pool->finished, NULL);
+
+	for (i = 0; i < nthreads - 1; ++i)
+	{
+		if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0)
+		{
+			threadpool_free(&pool);
+			return NULL;
+		}
+		pool->nworkers++;
+	}
+
+	return pool;
+}
+
+void threadpool_free(THREADPOOL** pool)
+{
+	int i;
+
+	assert(pool != NULL);
+
+	if (*pool == NULL)
+		return;
+
+	pthread_mutex_lock(&(*pool)->lock);
+	(*pool)->shutdown = 1;
+	pthread_cond_broadcast(&(*pool)->wakeup);
+	pthread_mutex_unlock(&(*pool)->lock);
+
+	for (i = 0; i < (*pool)->nworkers; ++i)
+		pthread_join((*pool)->threads[i], NULL);
+
+	pthread_cond_destroy(&(*pool)->finished);
+	pthread_cond_destroy(&(*pool)->wakeup);
+	pthread_mutex_destroy(&(*pool)->lock);
+
+	free((*pool)->threads);
+	free(*pool);
+	*pool = NULL;
+}
+
+int threadpool_ncores(void)
+{
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return n >= 1 ? (int) n : 1;
+}
+
+int threadpool_nthreads(const THREADPOOL* pool)
+{
+	return pool == NULL ? 1 : pool->nworkers + 1;
+}
+
+void threadpool_run(THREADPOOL* pool, POOLTASK task, void* arg, int ntasks)
+{
+	int t;
+
+	assert(task != NULL);
+
+	if (pool == NULL || pool->nworkers == 0 || ntasks <= 1)
+	{
+		for (t = 0; t < ntasks; ++t)
+			task(arg, t);
+		return;
+	}
+
+	pthread_mutex_lock(&pool->lock);
+
+	pool->task = task;
+	pool->arg = arg;
+	pool->ntasks = ntasks;
+	pool->next = 0;
+	pool->ndone = 0;
+	pool->batch++;
+	pthread_cond_broadcast(&pool->wakeup);
+
+	// the calling thread works on the batch as well
+	run_tasks(pool);
+
+	while (pool->ndone < pool->ntasks)
+		pthread_cond_wait(&pool->finished, &pool->lock);
+
+	pool->task = NULL;
+	pool->arg = NULL;
+
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/* takes tasks of the current batch until none is left; called and returns
+ * with the lock held */
+static
+void run_tasks(THREADPOOL *pool)
+{
+	while (pool->next < pool->ntasks)
+	{
+		POOLTASK task = pool->task;
+		void *arg = pool->arg;
+		int t = pool->next++;
+
+		pthread_mutex_unlock(&pool->lock);
+		task(arg, t);
+		pthread_mutex_lock(&pool->lock);
+
+		if (++pool->ndone == pool->ntasks)
+			pthread_cond_broadcast(&pool->finished);
+	}
+}
+
+static
+void* worker_main(void *data)
+{
+	THREADPOOL *pool = (THREADPOOL*) data;
+	long seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+
+	for (;;)
+	{
+		while (pool->batch == seen && !pool->shutdown)
+			pthread_cond_wait(&pool->wakeup, &pool->lock);
+
+		if (pool->shutdown)
+			break;
+
+		seen = pool->batch;
+		run_tasks(pool);
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
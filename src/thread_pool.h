@@ -0,0 +1,32 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/* a task of a batch, called with the batch argument and the task index */
+typedef void (*POOLTASK)(void* arg, int task);
+
+typedef struct thread_pool THREADPOOL;
+
+/* starts a pool of nthreads - 1 workers, the thread that runs a batch is
+ * the last one; returns NULL if the threads cannot be started */
+extern THREADPOOL*
+threadpool_create(int nthreads);
+
+/* stops the workers, frees the pool and sets *pool to NULL */
+extern void
+threadpool_free(THREADPOOL** pool);
+
+/* number of processors online, at least 1 */
+extern int
+threadpool_ncores(void);
+
+/* number of threads a batch runs on, including the calling one */
+extern int
+threadpool_nthreads(const THREADPOOL* pool);
+
+/* calls task(arg, t) for t = 0..ntasks-1 on the threads of the pool and
+ * returns when all calls have returned; the order in which the tasks run is
+ * unspecified. pool may be NULL to run the tasks in the calling thread */
+extern void
+threadpool_run(THREADPOOL* pool, POOLTASK task, void* arg, int ntasks);
+
+#endif
@@ -0,0 +1,243 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "tp3b_format.h"
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// function prototypes
+static uint64_t align8(uint64_t offset);
+static int write_section(FILE *file, const void *data, size_t size, uint64_t offset);
+static int check_times(const char *path, const TEST *tests, int numTests, const VEHICLE *vehicles, int numVehicles);
+static int bad_offset(uint64_t offset);
+
+int write_tp3b(const char* path, const INSTANCE* inst)
+{
+	TP3BHEADER header;
+	FILE *file;
+
+	assert(inst != NULL);
+
+	memset(&header, 0, sizeof(TP3BHEADER));
+	header.magic = TP3B_MAGIC;
+	header.version = TP3B_VERSION;
+	header.testSize = sizeof(TEST);
+	header.vehicleSize = sizeof(VEHICLE);
+	header.numTests = inst->numTests;
+	header.numVehicles = inst->numVehicles;
+	header.maxTestId = inst->maxTestId;
+	header.rehitWords = (inst->numTests + 63) / 64;
+
+	header.testsOffset = align8(sizeof(TP3BHEADER));
+	header.vehiclesOffset = align8(header.testsOffset + (uint64_t) inst->numTests * sizeof(TEST));
+	header.remapOffset = align8(header.vehiclesOffset + (uint64_t) inst->numVehicles * sizeof(VEHICLE));
+	header.rehitOffset = align8(header.remapOffset + (uint64_t) (inst->maxTestId + 1) * sizeof(int));
+	header.fileSize = header.rehitOffset + (uint64_t) inst->numTests * header.rehitWords * sizeof(uint64_t);
+
+	file = fopen(path, "wb");
+	if (file == NULL)
+	{
+		fprintf(stderr, "%s: cannot open file for writing\n", path);
+		return -1;
+	}
+
+	if (write_section(file, &header, sizeof(TP3BHEADER), 0) != 0
+		|| write_section(file, inst->tests, inst->numTests * sizeof(TEST), header.testsOffset) != 0
+		|| write_section(file, inst->vehicles, inst->numVehicles * sizeof(VEHICLE), header.vehiclesOffset) != 0
+		|| write_section(file, inst->idRemap, (inst->maxTestId + 1) * sizeof(int), header.remapOffset) != 0)
+	{
+		fclose(file);
+		return -1;
+	}
+
+	// the rehit matrix has the same row major word layout as the file
+	assert(inst->rehits->nwords == header.rehitWords);
+	if (write_section(file, inst->rehits->words, (size_t) inst->numTests * header.rehitWords * sizeof(uint64_t),
+			header.rehitOffset) != 0)
+	{
+		fclose(file);
+		return -1;
+	}
+
+	if (fclose(file) != 0)
+		return -1;
+
+	return 0;
+}
+
+int map_tp3b(const char* path, TP3BMAP* map)
+{
+	const TP3BHEADER *header;
+	struct stat st;
+	int fd;
+
+	assert(map != NULL);
+
+	memset(map, 0, sizeof(TP3BMAP));
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		fprintf(stderr, "%s: cannot open file\n", path);
+		return -1;
+	}
+
+	if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(TP3BHEADER))
+	{
+		fprintf(stderr, "%s: not a tp3b file\n", path);
+		close(fd);
+		return -1;
+	}
+
+	map->size = (size_t) st.st_size;
+	map->base = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (map->base == MAP_FAILED)
+	{
+		fprintf(stderr, "%s: cannot map file\n", path);
+		map->base = NULL;
+		return -1;
+	}
+
+	header = (const TP3BHEADER*) map->base;
+	if (header->magic != TP3B_MAGIC || header->version != TP3B_VERSION
+		|| header->testSize != sizeof(TEST) || header->vehicleSize != sizeof(VEHICLE)
+		|| header->fileSize != map->size || header->numTests < 0 || header->numVehicles < 0
+		|| header->maxTestId < -1
+		|| header->rehitWords != (header->numTests + 63) / 64
+		|| bad_offset(header->testsOffset) || bad_offset(header->vehiclesOffset)
+		|| bad_offset(header->remapOffset) || bad_offset(header->rehitOffset)
+		|| header->testsOffset + (uint64_t) header->numTests * sizeof(TEST) > header->vehiclesOffset
+		|| header->vehiclesOffset + (uint64_t) header->numVehicles * sizeof(VEHICLE) > header->remapOffset
+		|| header->remapOffset + (uint64_t) (header->maxTestId + 1) * sizeof(int) > header->rehitOffset
+		|| header->rehitOffset + (uint64_t) header->numTests * header->rehitWords * sizeof(uint64_t) > map->size)
+	{
+		fprintf(stderr, "%s: invalid or incompatible tp3b file (version %u)\n", path, header->version);
+		unmap_tp3b(map);
+		return -1;
+	}
+
+	/* the labeling complements rehit rows word by word, so bits past the last test must be clear */
+	if (header->numTests % 64 != 0)
+	{
+		const uint64_t* rows = (const uint64_t*) ((const char*) map->base + header->rehitOffset);
+		uint64_t padding = ~(uint64_t) 0 << (header->numTests % 64);
+
+		for (int i = 0; i < header->numTests; ++i)
+		{
+			if ((rows[(size_t) i * header->rehitWords + header->rehitWords - 1] & padding) != 0)
+			{
+				fprintf(stderr, "%s: rehit row %d has bits past the last test\n", path, i);
+				unmap_tp3b(map);
+				return -1;
+			}
+		}
+	}
+
+	if (check_times(path, (const TEST*) ((const char*) map->base + header->testsOffset), header->numTests,
+		(const VEHICLE*) ((const char*) map->base + header->vehiclesOffset), header->numVehicles) != 0)
+	{
+		unmap_tp3b(map);
+		return -1;
+	}
+
+	// the arrays are used in place
+	map->header = header;
+	map->tests = (const TEST*) ((const char*) map->base + header->testsOffset);
+	map->vehicles = (const VEHICLE*) ((const char*) map->base + header->vehiclesOffset);
+	map->idRemap = (const int*) ((const char*) map->base + header->remapOffset);
+	map->rehits = (const uint64_t*) ((const char*) map->base + header->rehitOffset);
+	map->numTests = header->numTests;
+	map->numVehicles = header->numVehicles;
+	map->maxTestId = header->maxTestId;
+	map->rehitWords = header->rehitWords;
+
+	return 0;
+}
+
+void unmap_tp3b(TP3BMAP* map)
+{
+	assert(map != NULL);
+
+	if (map->base != NULL)
+		munmap(map->base, map->size);
+
+	memset(map, 0, sizeof(TP3BMAP));
+}
+
+/* sections start 8 byte aligned after the header */
+static
+int bad_offset(uint64_t offset)
+{
+	return offset < sizeof(TP3BHEADER) || offset % 8 != 0;
+}
+
+/* returns 0 if every test takes time and all times are within the horizon,
+ * prints the first offending record and returns -1 otherwise */
+static
+int check_times(const char *path, const TEST *tests, int numTests, const VEHICLE *vehicles, int numVehicles)
+{
+	uint64_t totalDur = 0;
+
+	for (int i = 0; i < numTests; ++i)
+	{
+		if (tests[i].dur == 0 || tests[i].release > tests[i].deadline || tests[i].deadline > TP3B_HORIZON)
+		{
+			fprintf(stderr, "%s: test %d has duration %u, release %u and deadline %u\n", path, i,
+				tests[i].dur, tests[i].release, tests[i].deadline);
+			return -1;
+		}
+		totalDur += tests[i].dur;
+	}
+
+	if (totalDur > TP3B_HORIZON)
+	{
+		fprintf(stderr, "%s: the test durations sum up to more than %u\n", path, TP3B_HORIZON);
+		return -1;
+	}
+
+	for (int v = 0; v < numVehicles; ++v)
+	{
+		if (vehicles[v].release > TP3B_HORIZON)
+		{
+			fprintf(stderr, "%s: vehicle %d has release %u\n", path, v, vehicles[v].release);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static
+uint64_t align8(uint64_t offset)
+{
+	return (offset + 7) & ~(uint64_t) 7;
+}
+
+/* writes size bytes at the given offset, the gap before it is zero filled */
+static
+int write_section(FILE *file, const void *data, size_t size, uint64_t offset)
+{
+	long pos = ftell(file);
+
+	for (; pos >= 0 && (uint64_t) pos < offset; ++pos)
+	{
+		if (fputc(0, file) == EOF)
+			return -1;
+	}
+
+	if (pos < 0 || (uint64_t) pos != offset)
+		return -1;
+
+	if (size > 0 && fwrite(data, 1, size, file) != size)
+		return -1;
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef TP3B_FORMAT_H
+#define TP3B_FORMAT_H
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "data_structure.h"
+
+#define TP3B_MAGIC		0x42335054u		/* "TP3B" read as a little endian word */
+#define TP3B_VERSION	1u
+
+/* largest time a file may hold, also bounding the summed test durations; the
+ * schedules are timed in int, and no test ends later than the last release
+ * plus all durations */
+#define TP3B_HORIZON	((unsigned int) (INT_MAX / 2))
+
+/* fixed size header at the start of a .tp3b file; all sections start at a
+ * multiple of 8 bytes from the beginning of the file */
+struct tp3b_header
+{
+	uint32_t	magic;
+	uint32_t	version;
+	uint32_t	testSize;			/* sizeof(TEST) of the writer */
+	uint32_t	vehicleSize;		/* sizeof(VEHICLE) of the writer */
+	int32_t		numTests;
+	int32_t		numVehicles;
+	int32_t		maxTestId;
+	int32_t		rehitWords;			/* 64 bit words per row of the rehit bitset */
+	uint64_t	testsOffset;
+	uint64_t	vehiclesOffset;
+	uint64_t	remapOffset;		/* maxTestId + 1 ints, file test id -> dense id */
+	uint64_t	rehitOffset;		/* numTests rows of rehitWords words, row major */
+	uint64_t	fileSize;
+};
+
+typedef struct tp3b_header TP3BHEADER;
+
+/* a mapped .tp3b file, all pointers point into the read only mapping */
+struct tp3b_map
+{
+	void*				base;
+	size_t				size;
+	const TP3BHEADER*	header;
+	const TEST*			tests;
+	const VEHICLE*		vehicles;
+	const int*			idRemap;
+	const uint64_t*		rehits;
+	int					numTests;
+	int					numVehicles;
+	int					maxTestId;
+	int					rehitWords;
+};
+
+typedef struct tp3b_map TP3BMAP;
+
+/* writes inst in the binary format; returns 0 on success and -1 on error */
+extern int
+write_tp3b(const char* path, const INSTANCE* inst);
+
+/* maps the file read only into memory and checks its header and records;
+ * returns 0 on success and -1 if the file cannot be mapped or is not a valid
+ * .tp3b file */
+extern int
+map_tp3b(const char* path, TP3BMAP* map);
+
+/* unmaps a file mapped by map_tp3b */
+extern void
+unmap_tp3b(TP3BMAP* map);
+
+#endif
@@ -1,64 +1,72 @@
 #include "probdata_tp3s.h"
 #include "vardata_tp3s.h"
+#include "bitmatrix.h"
 
+/* the header of a column record in the column arena; the signature, the sorted tests and the sequence follow it in
+ * the same record, so a column takes one pointer bump and nothing has to be freed per column */
 struct SCIP_VarData
 {
 	int*			testConsids;
+	int*			sequence;		/* the tests in the order they are served */
+	uint64_t*		signature;		/* the tests as a bitset, for membership tests in word operations */
+	SCIP_Real		cost;			/* objective coefficient of the column */
 	int				nconsids;
 	int				vehicleConsid;
+	int				pos;			/* position of the column in the variable array of the problem data */
+	int				nfixings;		/* local fixings by the branching decisions, which nodes of the tree may still hold */
 };
 
 static
 SCIP_RETCODE vardataCreate(
 	SCIP*					scip,
 	SCIP_VARDATA**			vardata,
-	int*					testConsids,
+	COLARENA*				arena,
+	const int*				testConsids,
 	int						nconsids,
-	int						vehicleConsid
+	int						vehicleConsid,
+	SCIP_Real				cost
 	)
 {
-	SCIP_CALL( SCIPallocBlockMemory(scip, vardata) );
-	SCIP_CALL( SCIPduplicateBlockMemoryArray(scip, &(*vardata)->testConsids, testConsids, nconsids) );
+	size_t header = colarena_align(sizeof(SCIP_VARDATA));
+	size_t sigbytes = (size_t) arena->nwords * sizeof(uint64_t);
+	char* record;
 
-   	SCIPsortInt((*vardata)->testConsids, nconsids);
-
-   	(*vardata)->nconsids = nconsids;
-   	(*vardata)->testConsids = testConsids;
+	record = (char*) colarena_alloc(arena, header + sigbytes + 2 * (size_t) nconsids * sizeof(int));
+	if (record == NULL)
+		return SCIP_NOMEMORY;
 
-   	return SCIP_OKAY;
-}
+	*vardata = (SCIP_VARDATA*) record;
+	(*vardata)->signature = (uint64_t*) (record + header);
+	(*vardata)->testConsids = (int*) (record + header + sigbytes);
+	(*vardata)->sequence = (*vardata)->testConsids + nconsids;
 
-/** frees user data of variable */
-static
-SCIP_RETCODE vardataDelete(
-   SCIP*                 scip,               /**< SCIP data structure */
-   SCIP_VARDATA**        vardata             /**< vardata to delete */
-   )
-{
-   SCIPfreeBlockMemoryArray(scip, &(*vardata)->testConsids, (*vardata)->nconsids);
-   SCIPfreeBlockMemory(scip, vardata);
+	BMScopyMemoryArray((*vardata)->testConsids, testConsids, nconsids);
+	BMScopyMemoryArray((*vardata)->sequence, testConsids, nconsids);
+	for (int i = 0; i < nconsids; ++i)
+		bitset_set((*vardata)->signature, testConsids[i]);
 
-   return SCIP_OKAY;
-}
+   	SCIPsortInt((*vardata)->testConsids, nconsids);
 
-/** frees user data of transformed variable (called when the transformed variable is freed) */
-static
-SCIP_DECL_VARDELTRANS(vardataDelTrans)
-{
-   SCIP_CALL( vardataDelete(scip, vardata) );
+   	(*vardata)->nconsids = nconsids;
+   	(*vardata)->vehicleConsid = vehicleConsid;
+   	(*vardata)->cost = cost;
+   	(*vardata)->pos = -1;
+   	(*vardata)->nfixings = 0;
 
-   return SCIP_OKAY;
+   	return SCIP_OKAY;
 }
 
 /** create variable data */
 SCIP_RETCODE SCIPvardataCreateTP3S(
    SCIP*                 scip,               /**< SCIP data structure */
    SCIP_VARDATA**        vardata,            /**< pointer to vardata */
-   int*                  testConsids,            /**< array of constraints ids */
+   COLARENA*             arena,              /**< arena the column record is allocated from */
+   const int*            testConsids,            /**< array of constraints ids in the order the tests are served */
    int                   nconsids,            /**< number of constraints */
-   int 					 vehicleConsid)
+   int 					 vehicleConsid,
+   SCIP_Real             cost)
 {
-   SCIP_CALL( vardataCreate(scip, vardata, testConsids, nconsids, vehicleConsid) );
+   SCIP_CALL( vardataCreate(scip, vardata, arena, testConsids, nconsids, vehicleConsid, cost) );
 
    return SCIP_OKAY;
 }
@@ -82,7 +90,7 @@ int* SCIPvardataGetConsids(
    {
       int i;
 
-      for( i = 1; i < vardata->testConsids; ++i )
+      for( i = 1; i < vardata->nconsids; ++i )
          assert( vardata->testConsids[i-1] < vardata->testConsids[i]);
    }
 #endif
@@ -90,12 +98,80 @@ int* SCIPvardataGetConsids(
    return vardata->testConsids;
 }
 
+/** returns the tests of the column as a bitset */
+const uint64_t* SCIPvardataGetSignature(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->signature;
+}
+
+/** returns the constraint ids in the order the tests are served */
+int* SCIPvardataGetSequence(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->sequence;
+}
+
 int SCIPvardataGetVehicleConsids(
    SCIP_VARDATA*        vardata)
 {
    return vardata->vehicleConsid;
 }
 
+/** returns the objective coefficient the column was created with */
+SCIP_Real SCIPvardataGetCost(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->cost;
+}
+
+/** returns the position of the column in the variable array of the problem data, -1 if it is not there */
+int SCIPvardataGetPos(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->pos;
+}
+
+/** sets the position of the column in the variable array of the problem data */
+void SCIPvardataSetPos(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int                   pos                 /**< position, -1 if the column left the array */
+   )
+{
+   vardata->pos = pos;
+}
+
+/** returns the number of local fixings of the column by branching decisions */
+int SCIPvardataGetNFixings(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   )
+{
+   return vardata->nfixings;
+}
+
+void SCIPvardataGetName(
+   SCIP_VARDATA*         vardata,
+   char*                 name,
+   int                   size
+   )
+{
+   int len;
+
+   assert(vardata != NULL);
+   assert(vardata->nconsids >= 1);
+
+   /* the tests in sequence order, e.g. item_3,7_on_vehicle_1 */
+   len = SCIPsnprintf(name, size, "item_%d", vardata->sequence[0]);
+   for( int k = 1; k < vardata->nconsids && len < size; ++k )
+      len += SCIPsnprintf(name + len, size - len, ",%d", vardata->sequence[k]);
+   if( len < size )
+      (void) SCIPsnprintf(name + len, size - len, "_on_vehicle_%d", vardata->vehicleConsid);
+}
+
 /** creates variable */
 SCIP_RETCODE SCIPcreateVarTP3S(
    SCIP*                 scip,               /**< SCIP data structure */
@@ -114,9 +190,8 @@ SCIP_RETCODE SCIPcreateVarTP3S(
    SCIP_CALL( SCIPcreateVarBasic(scip, var, name, 0.0, 1.0, obj, SCIP_VARTYPE_BINARY) );
    assert(*var != NULL);
 
-   /* set callback functions */
+   /* the data lives in the column arena of the problem data, so there is nothing to free with the variable */
    SCIPvarSetData(*var, vardata);
-   SCIPvarSetDeltransData(*var, vardataDelTrans);
 
    /* set initial and removable flag */
    SCIP_CALL( SCIPvarSetInitial(*var, initial) );
@@ -131,6 +206,42 @@ SCIP_RETCODE SCIPcreateVarTP3S(
 
 
 
+/** fixes a column violating a branching decision to zero at the current node and counts the fixing */
+SCIP_RETCODE SCIPfixVarTP3S(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var,                /**< column to fix */
+   SCIP_Bool*            cutoff,             /**< pointer to store whether the node is infeasible */
+   int*                  nfixedvars          /**< pointer to count the fixed columns */
+   )
+{
+   SCIP_VARDATA* vardata;
+   SCIP_Bool infeasible;
+   SCIP_Bool fixed;
+
+   vardata = SCIPvarGetData(var);
+   assert(vardata != NULL);
+
+   SCIP_CALL( SCIPfixVar(scip, var, 0.0, &infeasible, &fixed) );
+
+   if( infeasible )
+   {
+      assert(SCIPvarGetLbLocal(var) > 0.5);
+      SCIPdebugMessage("-> cutoff\n");
+      *cutoff = TRUE;
+   }
+   else
+   {
+      assert(fixed);
+      (*nfixedvars)++;
+
+      /* probing fixings are undone when the dive ends, the others keep the column in the problem */
+      if( !SCIPinProbing(scip) )
+         vardata->nfixings++;
+   }
+
+   return SCIP_OKAY;
+}
+
 /** prints vardata to file stream */
 void SCIPvardataPrint(
    SCIP*                 scip,               /**< SCIP data structure */
@@ -138,5 +249,8 @@ void SCIPvardataPrint(
    FILE*                 file                /**< the text file to store the information into */
    )
 {
-   // place holder, do nothing
+   char name[SCIP_MAXSTRLEN];
+
+   SCIPvardataGetName(vardata, name, SCIP_MAXSTRLEN);
+   SCIPinfoMessage(scip, file, "%s\n", name);
 }
\ No newline at end of file
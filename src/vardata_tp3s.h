@@ -2,14 +2,18 @@
 #define _SCIP_VARDATA_TP3S_ 
 
 #include "scip/scip.h"
+#include "col_arena.h"
 
+/** creates the data of a column in the column arena; it is freed with the arena, not with the variable */
 extern 
 SCIP_RETCODE SCIPvardataCreateTP3S(
 	SCIP*			scip,
 	SCIP_VARDATA**	vardata,
-	int*			testConsids,
+	COLARENA*		arena,
+	const int*		testConsids,
 	int				nconsids,
-	int				vehicleConsids
+	int				vehicleConsids,
+	SCIP_Real		cost
 	);
 
 /** get number of constraints */
@@ -24,12 +28,59 @@ int* SCIPvardataGetConsids(
    SCIP_VARDATA*         vardata             /**< variable data */
    );
 
+/** returns the tests of the column as a bitset over the test constraint ids */
+extern
+const uint64_t* SCIPvardataGetSignature(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** returns the constraint id array in the order the tests are served */
+extern
+int* SCIPvardataGetSequence(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
 /** return vehicle constraint id */
 extern
 int SCIPvardataGetVehicleConsids(
    SCIP_VARDATA*         vardata
    );
 
+/** returns the objective coefficient the column was created with */
+extern
+SCIP_Real SCIPvardataGetCost(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** returns the position of the column in the variable array of the problem data, -1 if it is not there; deleted
+ *  columns keep their record, so that the column pool can add them again */
+extern
+int SCIPvardataGetPos(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** sets the position of the column in the variable array of the problem data */
+extern
+void SCIPvardataSetPos(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   int                   pos                 /**< position, -1 if the column left the array */
+   );
+
+/** returns the number of local fixings of the column by branching decisions */
+extern
+int SCIPvardataGetNFixings(
+   SCIP_VARDATA*         vardata             /**< variable data */
+   );
+
+/** writes the name of the column into name, built from its tests in sequence order and its vehicle row; columns
+ *  created without a name can be identified this way when debugging */
+extern
+void SCIPvardataGetName(
+   SCIP_VARDATA*         vardata,            /**< variable data */
+   char*                 name,               /**< buffer for the name */
+   int                   size                /**< size of the buffer */
+   );
+
 
 /** creates variable */
 extern
@@ -43,6 +94,16 @@ SCIP_RETCODE SCIPcreateVarTP3S(
    SCIP_VARDATA*         vardata             /**< user data for this specific variable */
    );
 
+/** fixes a column violating a branching decision to zero at the current node and counts the fixing; a fixing
+ *  outside probing is stored with a node of the tree, so the column must not be deleted from the problem any more */
+extern
+SCIP_RETCODE SCIPfixVarTP3S(
+   SCIP*                 scip,               /**< SCIP data structure */
+   SCIP_VAR*             var,                /**< column to fix */
+   SCIP_Bool*            cutoff,             /**< pointer to store whether the node is infeasible */
+   int*                  nfixedvars          /**< pointer to count the fixed columns */
+   );
+
 
 /** prints vardata to file stream */
 extern